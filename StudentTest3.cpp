@@ -0,0 +1,1866 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <list>
+#include <map>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+#include "doctest.h"
+#include "sources/Fraction.hpp"
+#include "sources/BigFraction.hpp"
+#include "sources/LazyFraction.hpp"
+#include "sources/FlatHashMap.hpp"
+#include "sources/FractionAccumulator.hpp"
+#include "sources/FractionArray.hpp"
+#include "sources/FractionSort.hpp"
+#include "sources/FractionSum.hpp"
+#include "sources/ThreadPool.hpp"
+
+using namespace std;
+using namespace ariel;
+
+TEST_SUITE("GCD engines") {
+
+    TEST_CASE("Zero and trivial arguments") {
+        CHECK_EQ(gcd::euclid(0u, 0u), 0u);
+        CHECK_EQ(gcd::binary(0u, 0u), 0u);
+        CHECK_EQ(gcd::lehmer(0u, 0u), 0u);
+
+        CHECK_EQ(gcd::binary(0u, 12u), 12u);
+        CHECK_EQ(gcd::binary(12u, 0u), 12u);
+        CHECK_EQ(gcd::lehmer(0u, 12u), 12u);
+        CHECK_EQ(gcd::lehmer(12u, 0u), 12u);
+
+        CHECK_EQ(gcd::binary(1u << 31, 1u << 31), 1u << 31);
+        CHECK_EQ(gcd::binary(48u, 180u), 12u);
+        CHECK_EQ(gcd::lehmer(48u, 180u), 12u);
+    }
+
+    TEST_CASE("Worst case inputs (consecutive Fibonacci numbers)") {
+        CHECK_EQ(gcd::binary(1836311903u, 1134903170u), 1u);
+        CHECK_EQ(gcd::lehmer(1836311903u, 1134903170u), 1u);
+        CHECK_EQ(gcd::lehmer(7540113804746346429ull, 4660046610375530309ull), 1ull);
+        CHECK_EQ(gcd::lehmer(7540113804746346429ull * 2, 4660046610375530309ull * 2), 2ull);
+    }
+
+    TEST_CASE("All engines agree with std::gcd on random inputs") {
+        mt19937_64 rng(2023);
+        bool all_equal = true;
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            auto common = static_cast<uint32_t>(rng() % 1000 + 1);
+            auto num1 = static_cast<uint32_t>(rng() % (UINT32_MAX / common)) * common;
+            auto num2 = static_cast<uint32_t>(rng() % (UINT32_MAX / common)) * common;
+            auto expected = std::gcd(num1, num2);
+
+            all_equal = all_equal && gcd::euclid(num1, num2) == expected && gcd::binary(num1, num2) == expected && gcd::lehmer(num1, num2) == expected;
+
+            uint64_t wide1 = rng() >> (rng() % 64), wide2 = rng() >> (rng() % 64);
+            auto wide_expected = std::gcd(wide1, wide2);
+
+            all_equal = all_equal && gcd::binary(wide1, wide2) == wide_expected && gcd::lehmer(wide1, wide2) == wide_expected;
+
+            uint128_t huge1 = (static_cast<uint128_t>(rng()) << 64 | rng()) >> (rng() % 128);
+            uint128_t huge2 = (static_cast<uint128_t>(rng()) << 64 | rng()) >> (rng() % 128);
+            uint128_t huge_common = wide1 | 1;
+
+            all_equal = all_equal && gcd::lehmer(huge1 * huge_common, huge2 * huge_common) == gcd::euclid(huge1 * huge_common, huge2 * huge_common);
+            all_equal = all_equal && gcd::binary(huge1, huge2) == gcd::euclid(huge1, huge2);
+        }
+
+        CHECK(all_equal);
+    }
+
+    TEST_CASE("Fraction reduces with the selected engine") {
+        CHECK_EQ(Fraction{1134903170, 1836311903}.getNumerator(), 1134903170);
+        CHECK_EQ(Fraction{-48, 180}, Fraction{-4, 15});
+        CHECK_EQ(Fraction{-48, 180}.getDenominator(), 15);
+    }
+}
+
+TEST_SUITE("Widened intermediate arithmetic") {
+
+    TEST_CASE("Big but reducible results don't overflow") {
+        CHECK_EQ(Fraction{1, 65536} + Fraction{1, 65536}, Fraction{1, 32768});
+        CHECK_EQ(Fraction{1, 65536} - Fraction{3, 65536}, Fraction{-1, 32768});
+        CHECK_EQ(Fraction{46341, 2} * Fraction{2, 46341}, Fraction{1, 1});
+        CHECK_EQ(Fraction{65536, 3} / Fraction{65536, 7}, Fraction{7, 3});
+        CHECK_EQ(Fraction{65536, 3} / Fraction{-65536, 7}, Fraction{-7, 3});
+    }
+
+    TEST_CASE("Results that don't fit in an int still throw") {
+        int max_int = std::numeric_limits<int>::max();
+
+        CHECK_THROWS_AS(Fraction(max_int, 1) + Fraction(1, 1), std::overflow_error);
+        CHECK_THROWS_AS(Fraction(1, max_int) * Fraction(1, 2), std::overflow_error);
+        CHECK_THROWS_AS(Fraction(max_int, 1) / Fraction(1, 2), std::overflow_error);
+    }
+
+    TEST_CASE("INT_MIN parts are reduced before their sign is fixed") {
+        int min_int = std::numeric_limits<int>::min();
+
+        CHECK_EQ(Fraction(min_int, -10), Fraction(1073741824, 5));
+        CHECK_EQ(Fraction(min_int, -2).getNumerator(), 1073741824);
+        CHECK_EQ(Fraction(min_int, min_int), Fraction(1, 1));
+        CHECK_EQ(Fraction(4, min_int), Fraction(-1, 536870912));
+        CHECK_EQ(Fraction(0, min_int).getDenominator(), 1);
+        CHECK_EQ(Fraction(min_int, 1).getNumerator(), min_int);
+        CHECK_THROWS_AS(Fraction(3, min_int), std::overflow_error);
+        CHECK_THROWS_AS(Fraction(min_int, -1), std::overflow_error);
+        CHECK_THROWS_AS(Fraction64(1, std::numeric_limits<std::int64_t>::min()), std::overflow_error);
+
+        Fraction read;
+        std::istringstream input("-2147483648 -10");
+        input >> read;
+        CHECK_EQ(read, Fraction(1073741824, 5));
+    }
+}
+
+TEST_SUITE("Cross-cancelled multiplication and division") {
+
+    TEST_CASE("Products are reduced") {
+        CHECK_EQ(Fraction{6, 35} * Fraction{14, 9}, Fraction{4, 15});
+        CHECK_EQ((Fraction{6, 35} * Fraction{14, 9}).getNumerator(), 4);
+        CHECK_EQ((Fraction{6, 35} * Fraction{14, 9}).getDenominator(), 15);
+        CHECK_EQ(Fraction{-6, 35} / Fraction{-9, 14}, Fraction{4, 15});
+        CHECK_EQ((Fraction{6, 35} / Fraction{-9, 14}).getDenominator(), 15);
+    }
+
+    TEST_CASE("Zero operands give the canonical zero") {
+        CHECK_EQ((Fraction{0, 1} * Fraction{3, 5}).getDenominator(), 1);
+        CHECK_EQ((Fraction{3, 5} * Fraction{0, 7}).getDenominator(), 1);
+        CHECK_EQ((Fraction{0, 1} / Fraction{-3, 5}).getDenominator(), 1);
+        CHECK_EQ((Fraction{0, 1} / Fraction{-3, 5}).getNumerator(), 0);
+    }
+
+    TEST_CASE("Cancellation avoids intermediate overflow") {
+        int max_int = std::numeric_limits<int>::max();
+
+        CHECK_EQ(Fraction(max_int, 3) * Fraction(3, max_int), Fraction(1, 1));
+        CHECK_EQ(Fraction(max_int, 2) / Fraction(max_int, 4), Fraction(2, 1));
+    }
+}
+
+TEST_SUITE("Henrici addition and subtraction") {
+
+    TEST_CASE("Equal denominators") {
+        CHECK_EQ(Fraction{1, 6} + Fraction{1, 6}, Fraction{1, 3});
+        CHECK_EQ(Fraction{1, 6} - Fraction{1, 6}, Fraction{0, 1});
+        CHECK_EQ((Fraction{1, 6} - Fraction{1, 6}).getDenominator(), 1);
+        CHECK_EQ(Fraction{5, 6} + Fraction{1, 6}, Fraction{1, 1});
+    }
+
+    TEST_CASE("Coprime and common factor denominators") {
+        CHECK_EQ(Fraction{1, 4} + Fraction{2, 9}, Fraction{17, 36});
+        CHECK_EQ(Fraction{7, 12} + Fraction{5, 18}, Fraction{31, 36});
+        CHECK_EQ(Fraction{1, 12} + Fraction{1, 60}, Fraction{1, 10});
+        CHECK_EQ((Fraction{1, 12} + Fraction{1, 60}).getDenominator(), 10);
+        CHECK_EQ(Fraction{1, 12} - Fraction{-1, 60}, Fraction{1, 10});
+    }
+
+    TEST_CASE("Agrees with the cross product definition") {
+        mt19937 rng(11);
+        uniform_int_distribution<int> numerators(-500, 500), denominators(1, 500);
+        bool all_equal = true;
+
+        for (int i = 0; i < 5000; ++i)
+        {
+            int num1 = numerators(rng), den1 = denominators(rng), num2 = numerators(rng), den2 = denominators(rng);
+
+            all_equal = all_equal && (Fraction{num1, den1} + Fraction{num2, den2}) == Fraction{num1 * den2 + num2 * den1, den1 * den2};
+            all_equal = all_equal && (Fraction{num1, den1} - Fraction{num2, den2}) == Fraction{num1 * den2 - num2 * den1, den1 * den2};
+        }
+
+        CHECK(all_equal);
+    }
+
+    TEST_CASE("Subtracting the smallest int doesn't overflow the negation") {
+        int min_int = std::numeric_limits<int>::min();
+
+        CHECK_EQ(Fraction(-1, 1) - Fraction(min_int, 1), Fraction(std::numeric_limits<int>::max(), 1));
+    }
+}
+
+TEST_SUITE("Three-way comparison") {
+
+    TEST_CASE("Ordering of fractions") {
+        CHECK((Fraction{1, 3} <=> Fraction{1, 2}) == std::strong_ordering::less);
+        CHECK((Fraction{2, 4} <=> Fraction{1, 2}) == std::strong_ordering::equal);
+        CHECK((Fraction{-1, 3} <=> Fraction{-1, 2}) == std::strong_ordering::greater);
+        CHECK((Fraction{-1, 3} <=> Fraction{0, 1}) == std::strong_ordering::less);
+        CHECK((Fraction{0, 1} <=> Fraction{1, 1000}) == std::strong_ordering::less);
+        CHECK((Fraction{3, 7} <=> Fraction{5, 7}) == std::strong_ordering::less);
+    }
+
+    TEST_CASE("Large values don't overflow the cross products") {
+        int max_int = std::numeric_limits<int>::max();
+        int min_int = std::numeric_limits<int>::min();
+
+        CHECK_LT(Fraction(max_int - 1, max_int), Fraction(max_int, max_int - 1));
+        CHECK_GT(Fraction(max_int, 2), Fraction(max_int - 2, 3));
+        CHECK_LT(Fraction(min_int, 3), Fraction(min_int + 1, 3));
+        CHECK_LT(Fraction(min_int, 1), Fraction(max_int, 1));
+        CHECK_LE(Fraction(max_int, 7), Fraction(max_int, 7));
+        CHECK_GE(Fraction(1, max_int), Fraction(1, max_int - 1) - Fraction(1, max_int - 1));
+    }
+
+    TEST_CASE("Relational operators with floats on both sides") {
+        CHECK_LT(Fraction{1, 3}, 0.5);
+        CHECK_GT(0.5, Fraction{1, 3});
+        CHECK_LE(0.25, Fraction{1, 4});
+        CHECK_GE(Fraction{1, 4}, 0.25);
+        CHECK_NE(0.3, Fraction{1, 3});
+    }
+}
+
+TEST_SUITE("Compile time fractions") {
+
+    TEST_CASE("The arithmetic and comparison core is constexpr") {
+        constexpr Fraction a(5, 3), b(14, 21);
+
+        static_assert(a.getNumerator() == 5 && a.getDenominator() == 3);
+        static_assert(b == Fraction(2, 3));
+        static_assert(a + b == Fraction(7, 3));
+        static_assert(a - b == Fraction(1, 1));
+        static_assert(a * b == Fraction(10, 9));
+        static_assert(a / b == Fraction(5, 2));
+        static_assert(a > b && b <= a && a != b);
+        static_assert(Fraction(0.5F) == Fraction(1, 2));
+        static_assert(a + 1.0F == Fraction(8, 3));
+
+        constexpr Fraction c = [] {
+            Fraction frac(1, 2);
+            ++frac;
+            frac--;
+            return frac;
+        }();
+        static_assert(c == Fraction(1, 2));
+
+        CHECK_EQ(a + b, Fraction(7, 3));
+    }
+}
+
+TEST_SUITE("BasicFraction instantiations") {
+
+    TEST_CASE("64-bit fractions hold ratios beyond 2^31") {
+        Fraction64 big(5000000000LL, 3);
+        CHECK_EQ(big.getNumerator(), 5000000000LL);
+        CHECK_EQ(big + Fraction64(1, 3), Fraction64(5000000001LL, 3));
+        CHECK_EQ(big * Fraction64(3, 5000000000LL), Fraction64(1, 1));
+        CHECK_EQ(Fraction64(4000000000LL, 7) / Fraction64(2000000000LL, 7), Fraction64(2, 1));
+        CHECK_LT(Fraction64(4000000000LL, 4000000001LL), Fraction64(4000000001LL, 4000000002LL));
+        CHECK_THROWS_AS(Fraction64(std::numeric_limits<std::int64_t>::max(), 1) + Fraction64(1, 1), std::overflow_error);
+    }
+
+    TEST_CASE("128-bit fractions use overflow checked intermediates") {
+        int128_t ten_to_30 = static_cast<int128_t>(1000000000000000LL) * 1000000000000000LL;
+        Fraction128 huge(ten_to_30, 7);
+
+        CHECK_EQ((huge * Fraction128(7, ten_to_30)), Fraction128(1, 1));
+        CHECK_EQ((huge - huge), Fraction128(0, 1));
+        CHECK_EQ((huge + Fraction128(1, 7)).getNumerator(), ten_to_30 + 1);
+        CHECK_THROWS_AS(huge * huge, std::overflow_error);
+        CHECK_THROWS_AS(Fraction128(std::numeric_limits<int128_t>::max(), 1) + Fraction128(1, 1), std::overflow_error);
+    }
+
+    TEST_CASE("128-bit comparisons don't need wider cross products") {
+        int128_t max_128 = std::numeric_limits<int128_t>::max();
+
+        CHECK_LT(Fraction128(max_128 - 1, max_128), Fraction128(max_128, max_128 - 1));
+        CHECK_GT(Fraction128(max_128 - 1, max_128 - 2), Fraction128(max_128, max_128 - 1));
+        CHECK_LT(Fraction128(-max_128, max_128 - 1), Fraction128(-(max_128 - 1), max_128));
+        CHECK_EQ((Fraction128(1, 3) <=> Fraction128(2, 6)), std::strong_ordering::equal);
+        CHECK_GT(Fraction128(1, 3), Fraction128(0, 1));
+        CHECK_LT(Fraction128(0, 1), Fraction128(1, max_128));
+    }
+
+    TEST_CASE("Stream operators for every width") {
+        std::stringstream stream("-170141183460469231731687303715884105728 3");
+        Fraction128 min_128;
+        stream >> min_128;
+
+        std::stringstream printed;
+        printed << min_128 << " " << Fraction64(6000000000LL, 7) << " " << Fraction(6, 4);
+        CHECK_EQ(printed.str(), "-170141183460469231731687303715884105728/3 6000000000/7 3/2");
+
+        std::stringstream too_big("170141183460469231731687303715884105728 1");
+        CHECK_THROWS_AS(too_big >> min_128, std::runtime_error);
+
+        std::stringstream floating("3.556 4");
+        CHECK_THROWS_AS(floating >> min_128, std::runtime_error);
+    }
+}
+
+TEST_SUITE("Auto-promoting BigFraction") {
+    TEST_CASE("BigInt arithmetic") {
+        BigInt big = BigInt(std::numeric_limits<long long>::max()) * BigInt(std::numeric_limits<long long>::max());
+        CHECK_EQ(big.to_string(), "85070591730234615847396907784232501249");
+        CHECK_EQ(big / BigInt(std::numeric_limits<long long>::max()), BigInt(std::numeric_limits<long long>::max()));
+        CHECK_EQ(big % BigInt(1000000007), BigInt(static_cast<int128_t>(big.to<int128_t>() % 1000000007)));
+        CHECK_EQ((big + BigInt(-1)) - big, BigInt(-1));
+        CHECK_EQ(BigInt::gcd(big, BigInt(std::numeric_limits<long long>::max()) * BigInt(6)), BigInt(std::numeric_limits<long long>::max()));
+        CHECK_LT(-big, BigInt(0));
+        CHECK_EQ((-big).to_string(), "-85070591730234615847396907784232501249");
+        CHECK_THROWS_AS(big / BigInt(0), std::runtime_error);
+
+        // Knuth's algorithm D with multi-limb divisors.
+        std::mt19937_64 rng(7);
+        for (int i = 0; i < 200; i++)
+        {
+            BigInt dividend = BigInt(rng()) * BigInt(rng()) * BigInt(rng());
+            BigInt divisor = BigInt(rng() >> (i % 60)) * BigInt(rng() | 1);
+            BigInt quotient, remainder;
+            BigInt::divmod(dividend, divisor, quotient, remainder);
+            CHECK_EQ(quotient * divisor + remainder, dividend);
+            CHECK_LT(remainder, divisor);
+        }
+    }
+
+    TEST_CASE("Small values stay inline") {
+        BigFraction frac1 = Fraction(1, 3), frac2(1, 6);
+
+        CHECK_EQ(sizeof(BigFraction), sizeof(Fraction));
+        CHECK(frac1.is_small());
+        CHECK_EQ((frac1 + frac2).to_fraction(), Fraction(1, 2));
+        CHECK_EQ((frac1 - frac2).to_fraction(), Fraction(1, 6));
+        CHECK_EQ((frac1 * frac2).to_fraction(), Fraction(1, 18));
+        CHECK_EQ((frac1 / frac2).to_fraction(), Fraction(2, 1));
+        CHECK_EQ(-frac1, BigFraction(-2, 6));
+        CHECK_GT(frac1, frac2);
+        CHECK_THROWS_AS(frac1 / BigFraction(), std::runtime_error);
+        CHECK_THROWS_AS(BigFraction(1, 0), std::invalid_argument);
+    }
+
+    TEST_CASE("Overflowing results are promoted instead of throwing") {
+        int max_int = std::numeric_limits<int>::max();
+        BigFraction big = BigFraction(Fraction(max_int, 1)) + BigFraction(Fraction(max_int, 1));
+
+        CHECK_THROWS_AS(Fraction(max_int, 1) + Fraction(max_int, 1), std::overflow_error);
+        CHECK_FALSE(big.is_small());
+        CHECK_EQ(big.numerator(), BigInt(2LL * max_int));
+        CHECK_THROWS_AS(big.to_fraction(), std::overflow_error);
+        CHECK_GT(big, BigFraction(Fraction(max_int, 1)));
+
+        BigFraction product = BigFraction(Fraction(1, max_int)) * BigFraction(Fraction(1, max_int - 1));
+        std::stringstream printed;
+        printed << product << " " << -BigFraction(Fraction(std::numeric_limits<int>::min(), 1));
+        CHECK_EQ(printed.str(), "1/4611686011984936962 2147483648/1");
+
+        // Copies of promoted values are deep.
+        BigFraction copy = big;
+        copy = copy * copy;
+        CHECK_EQ(big.numerator(), BigInt(2LL * max_int));
+        CHECK_EQ(copy.numerator(), BigInt(2LL * max_int) * BigInt(2LL * max_int));
+    }
+
+    TEST_CASE("Promoted values are demoted when they shrink") {
+        int max_int = std::numeric_limits<int>::max();
+        BigFraction big = BigFraction(Fraction(max_int, 1)) * BigFraction(Fraction(max_int, 1)) * BigFraction(Fraction(max_int, 1));
+        CHECK_FALSE(big.is_small());
+
+        BigFraction back = big / BigFraction(Fraction(max_int, 1)) / BigFraction(Fraction(max_int, 3));
+        CHECK_FALSE(back.is_small());
+
+        back = back / BigFraction(Fraction(3, 1));
+        CHECK(back.is_small());
+        CHECK_EQ(back.to_fraction(), Fraction(max_int, 1));
+        CHECK_EQ(big - big, BigFraction());
+        CHECK((big - big).is_small());
+    }
+
+    TEST_CASE("Harmonic sums never overflow") {
+        BigFraction sum;
+        double approx = 0;
+
+        for (int i = 1; i <= 60; i++)
+        {
+            sum = sum + BigFraction(1, i);
+            approx += 1.0 / i;
+        }
+
+        CHECK_FALSE(sum.is_small());
+        CHECK_EQ(sum.to_double(), doctest::Approx(approx));
+        CHECK_EQ((sum - sum + BigFraction(1, 2)).to_fraction(), Fraction(1, 2));
+    }
+
+    TEST_CASE("Conversion to double of parts beyond the range of double") {
+        // H(1200) has parts of about 1700 bits, each of them alone is inf as a double.
+        vector<Fraction> terms;
+        double approx = 0;
+
+        for (int i = 1; i <= 1200; i++)
+        {
+            terms.emplace_back(1, i);
+            approx += 1.0 / i;
+        }
+
+        const BigFraction harmonic = ariel::sum(terms);
+        CHECK_GT(harmonic.denominator().bit_width(), size_t{1100});
+        CHECK(std::isinf(harmonic.denominator().to_double()));
+        CHECK_EQ(harmonic.to_double(), doctest::Approx(approx));
+        CHECK_EQ((BigFraction() - harmonic).to_double(), doctest::Approx(-approx));
+
+        // 3^700 / 2^1200 and its reciprocal, about 2^-90.5 and 2^90.5.
+        BigInt power3(1), power2(1);
+
+        for (int i = 0; i < 700; i++)
+            power3 = power3 * BigInt(3);
+
+        for (int i = 0; i < 1200; i++)
+            power2 = power2 * BigInt(2);
+
+        CHECK_EQ(BigFraction(power3, power2).to_double(), doctest::Approx(std::exp2(700 * std::log2(3.0) - 1200)));
+        CHECK_EQ(BigFraction(power2, power3).to_double(), doctest::Approx(std::exp2(1200 - 700 * std::log2(3.0))));
+
+        // Results beyond the range of double are inf or 0, never nan.
+        CHECK(std::isinf(BigFraction(power2 * power2, BigInt(3)).to_double()));
+        CHECK_EQ(BigFraction(BigInt(3), power2 * power2).to_double(), 0.0);
+    }
+}
+
+TEST_SUITE("Overflow policies") {
+    TEST_CASE("ThrowOnOverflow is the default") {
+        CHECK((std::is_same_v<Fraction::policy_type, overflow::ThrowOnOverflow>));
+        CHECK_THROWS_AS(Fraction(std::numeric_limits<int>::max(), 1) + Fraction(1, 1), std::overflow_error);
+    }
+
+    TEST_CASE("SaturateOnOverflow clamps and raises the flag") {
+        int max_int = std::numeric_limits<int>::max();
+        int min_int = std::numeric_limits<int>::min();
+        overflow::clear();
+
+        CHECK_EQ(SaturatingFraction(1, 2) + SaturatingFraction(1, 3), SaturatingFraction(5, 6));
+        CHECK_FALSE(overflow::occurred());
+
+        CHECK_EQ(SaturatingFraction(max_int, 1) + SaturatingFraction(1, 1), SaturatingFraction(max_int, 1));
+        CHECK(overflow::occurred());
+
+        overflow::clear();
+        CHECK_EQ(SaturatingFraction(min_int, 1) * SaturatingFraction(2, 1), SaturatingFraction(-max_int, 1));
+        CHECK_EQ(SaturatingFraction(1, max_int) * SaturatingFraction(1, 2), SaturatingFraction(0, 1));
+        CHECK(overflow::occurred());
+
+        // The whole value saturates to the nearest fraction, the parts aren't clamped separately.
+        overflow::clear();
+        CHECK_EQ(SaturatingFraction(1, max_int) + SaturatingFraction(1, max_int - 1), SaturatingFraction(1, 1073741823));
+        CHECK_EQ(SaturatingFraction(max_int, 1) * SaturatingFraction(max_int, 3), SaturatingFraction(max_int, 1));
+        CHECK_EQ(SaturatingFraction(-max_int, 1) / SaturatingFraction(1, 2), SaturatingFraction(-max_int, 1));
+        CHECK_EQ(SaturatingFraction(1, 2) + 3000000000LL, SaturatingFraction(max_int, 1));
+        CHECK_EQ(SaturatingFraction(1, 3) / 3000000000LL, SaturatingFraction(0, 1));
+        CHECK(overflow::occurred());
+
+        // The constructor resolves a reduced fraction that doesn't fit like the operators do.
+        overflow::clear();
+        CHECK_EQ(SaturatingFraction(3, min_int), SaturatingFraction(-2, 1431655765));
+        CHECK_EQ(SaturatingFraction(min_int, -1), SaturatingFraction(max_int, 1));
+        CHECK(overflow::occurred());
+
+        using Saturating128 = BasicFraction<int128_t, overflow::SaturateOnOverflow>;
+        int128_t max_128 = std::numeric_limits<int128_t>::max();
+        overflow::clear();
+        CHECK_EQ(Saturating128(max_128, 1) + Saturating128(max_128, 1), Saturating128(max_128, 1));
+        CHECK_EQ(Saturating128(-max_128, 1) * Saturating128(3, 1), Saturating128(-max_128, 1));
+        CHECK_EQ(Saturating128(1, max_128) * Saturating128(1, max_128), Saturating128(0, 1));
+        CHECK(overflow::occurred());
+        overflow::clear();
+    }
+
+    TEST_CASE("FlagOnOverflow wraps and raises the flag") {
+        int max_int = std::numeric_limits<int>::max();
+        overflow::clear();
+
+        FlaggingFraction sum = FlaggingFraction(max_int, 1) + FlaggingFraction(1, 1);
+        CHECK_EQ(sum.getNumerator(), std::numeric_limits<int>::min());
+        CHECK(overflow::occurred());
+
+        overflow::clear();
+        CHECK_EQ(FlaggingFraction(max_int, 2) - FlaggingFraction(1, 2), FlaggingFraction(max_int - 1, 2));
+        CHECK_FALSE(overflow::occurred());
+
+        FlaggingFraction tiny(3, std::numeric_limits<int>::min());
+        CHECK_EQ(tiny.getNumerator(), -3);
+        CHECK(overflow::occurred());
+        overflow::clear();
+    }
+
+    TEST_CASE("UncheckedOverflow never checks") {
+        overflow::clear();
+
+        UncheckedFraction product = UncheckedFraction(65536, 1) * UncheckedFraction(65536, 1);
+        CHECK_EQ(product.getNumerator(), 0);
+        CHECK_FALSE(overflow::occurred());
+        CHECK_EQ(UncheckedFraction(1, 3) + UncheckedFraction(1, 6), UncheckedFraction(1, 2));
+    }
+
+    TEST_CASE("Division by zero throws with every policy") {
+        CHECK_THROWS_AS(SaturatingFraction(1, 2) / SaturatingFraction(0, 1), std::runtime_error);
+        CHECK_THROWS_AS(UncheckedFraction(1, 2) / UncheckedFraction(0, 1), std::runtime_error);
+
+        std::stringstream printed;
+        printed << SaturatingFraction(2, 4) << " " << UncheckedFraction(-3, 9);
+        CHECK_EQ(printed.str(), "1/2 -1/3");
+    }
+}
+
+TEST_SUITE("Checked arithmetic") {
+    TEST_CASE("Successful operations return the value") {
+        Fraction frac1(1, 3), frac2(1, 6);
+
+        CHECK_EQ(*Fraction::checked_add(frac1, frac2), Fraction(1, 2));
+        CHECK_EQ(*Fraction::checked_sub(frac1, frac2), Fraction(1, 6));
+        CHECK_EQ(*Fraction::checked_mul(frac1, frac2), Fraction(1, 18));
+        CHECK_EQ(*Fraction::checked_div(frac1, frac2), Fraction(2, 1));
+        CHECK(Fraction::checked_add(frac1, frac2).has_value());
+        CHECK_EQ(Fraction::checked_add(frac1, frac2).error(), FractionError::None);
+        CHECK(noexcept(Fraction::checked_add(frac1, frac2)));
+    }
+
+    TEST_CASE("Failures are returned instead of thrown") {
+        int max_int = std::numeric_limits<int>::max();
+        Fraction big(max_int, 1);
+
+        CHECK_EQ(Fraction::checked_add(big, Fraction(1, 1)).error(), FractionError::Overflow);
+        CHECK_EQ(Fraction::checked_sub(Fraction(-max_int, 1), Fraction(2, 1)).error(), FractionError::Overflow);
+        CHECK_EQ(Fraction::checked_mul(big, big).error(), FractionError::Overflow);
+        CHECK_EQ(Fraction::checked_div(big, Fraction(1, 2)).error(), FractionError::Overflow);
+        CHECK_EQ(Fraction::checked_div(big, Fraction()).error(), FractionError::DivisionByZero);
+        CHECK_FALSE(Fraction::checked_mul(big, big));
+        CHECK_EQ(Fraction::checked_mul(big, big).value_or(Fraction(-1, 1)), Fraction(-1, 1));
+        CHECK_EQ(std::string(message(FractionError::DivisionByZero)), "Can't divide by zero");
+
+        int128_t max_128 = std::numeric_limits<int128_t>::max();
+        CHECK_EQ(Fraction128::checked_mul(Fraction128(max_128, 1), Fraction128(2, 1)).error(), FractionError::Overflow);
+        CHECK_EQ(*Fraction128::checked_add(Fraction128(max_128, 2), Fraction128(-1, 2)), Fraction128(max_128 - 1, 2));
+    }
+
+    TEST_CASE("The caller's overflow flag is preserved") {
+        overflow::clear();
+        CHECK_FALSE(Fraction::checked_mul(Fraction(65536, 1), Fraction(65536, 1)));
+        CHECK_FALSE(overflow::occurred());
+
+        (void)(FlaggingFraction(65536, 1) * FlaggingFraction(65536, 1));
+        CHECK(Fraction::checked_add(Fraction(1, 2), Fraction(1, 2)));
+        CHECK(overflow::occurred());
+        overflow::clear();
+    }
+
+    TEST_CASE("Checked construction") {
+        int min_int = std::numeric_limits<int>::min();
+
+        CHECK_EQ(*Fraction::checked_make(6, -4), Fraction(-3, 2));
+        CHECK_EQ(*Fraction::checked_make(2, min_int), Fraction(-1, 1 << 30));
+        CHECK_EQ(*Fraction::checked_make(min_int, min_int), Fraction(1, 1));
+        CHECK_EQ(Fraction::checked_make(min_int, -1).error(), FractionError::Overflow);
+        CHECK_EQ(Fraction::checked_make(1, 0).error(), FractionError::ZeroDenominator);
+        static_assert(*Fraction::checked_make(10, 4) == Fraction(5, 2));
+    }
+
+    TEST_CASE("Checked parsing") {
+        CHECK_EQ(*Fraction::checked_parse("3/6"), Fraction(1, 2));
+        CHECK_EQ(*Fraction::checked_parse("  -10 4 "), Fraction(-5, 2));
+        CHECK_EQ(*Fraction::checked_parse("-2147483648/2"), Fraction(-1073741824, 1));
+        CHECK_EQ(*Fraction128::checked_parse("-170141183460469231731687303715884105728/3"), Fraction128(std::numeric_limits<int128_t>::min(), 3));
+        CHECK_EQ(Fraction::checked_parse("2147483648/3").error(), FractionError::Overflow);
+        CHECK_EQ(Fraction::checked_parse("1/0").error(), FractionError::ZeroDenominator);
+        CHECK_EQ(Fraction::checked_parse("3.5/2").error(), FractionError::InvalidInput);
+        CHECK_EQ(Fraction::checked_parse("1/2x").error(), FractionError::InvalidInput);
+        CHECK_EQ(Fraction::checked_parse("").error(), FractionError::InvalidInput);
+        static_assert(*Fraction::checked_parse("9/12") == Fraction(3, 4));
+    }
+}
+
+TEST_SUITE("Lazy normalization") {
+    TEST_CASE("Results stay unreduced while they fit") {
+        LazyFraction frac1(5, 3), frac2(14, 21);
+        LazyFraction chain = frac1 + frac2 - 1;
+
+        CHECK_FALSE(frac2.is_reduced());
+        CHECK_FALSE(chain.is_reduced());
+        CHECK_EQ(chain, LazyFraction(4, 3));
+        CHECK_FALSE(chain.is_reduced());
+
+        // The const observers reduce a copy, only normalize() stores the reduced parts.
+        CHECK_EQ(chain.getNumerator(), 4);
+        CHECK_EQ(chain.getDenominator(), 3);
+        CHECK_FALSE(chain.is_reduced());
+        CHECK(chain.normalize().is_reduced());
+        static_assert(LazyFraction(14, 21).getDenominator() == 3);
+        CHECK_EQ(chain.getNumerator(), 4);
+        CHECK_EQ(chain.getDenominator(), 3);
+        CHECK_EQ(chain.to_fraction(), Fraction(5, 3) + Fraction(14, 21) - 1);
+    }
+
+    TEST_CASE("Every operator matches Fraction") {
+        std::mt19937 rng(11);
+        std::uniform_int_distribution<int> numerators(-300, 300), denominators(1, 300);
+
+        for (int i = 0; i < 200; i++)
+        {
+            Fraction frac1(numerators(rng), denominators(rng)), frac2(numerators(rng), denominators(rng));
+            LazyFraction lazy1 = frac1, lazy2 = frac2;
+
+            CHECK_EQ((lazy1 + lazy2).to_fraction(), frac1 + frac2);
+            CHECK_EQ((lazy1 - lazy2).to_fraction(), frac1 - frac2);
+            CHECK_EQ((lazy1 * lazy2).to_fraction(), frac1 * frac2);
+            CHECK_EQ((lazy1 <=> lazy2), (frac1 <=> frac2));
+
+            if (frac2.getNumerator() != 0)
+                CHECK_EQ((lazy1 / lazy2).to_fraction(), frac1 / frac2);
+        }
+    }
+
+    TEST_CASE("Results are reduced when they would overflow") {
+        int max_int = std::numeric_limits<int>::max();
+        LazyFraction frac(max_int - 1, 2);
+
+        CHECK_FALSE(frac.is_reduced());
+        LazyFraction product = frac * LazyFraction(2, 1);
+        CHECK(product.is_reduced());
+        CHECK_EQ(product, LazyFraction(max_int - 1, 1));
+
+        CHECK_THROWS_AS(LazyFraction(max_int, 1) + LazyFraction(1, 1), std::overflow_error);
+        CHECK_THROWS_AS(LazyFraction(1, 2) / LazyFraction(0, 5), std::runtime_error);
+        CHECK_THROWS_AS(LazyFraction(1, 0), std::invalid_argument);
+    }
+
+    TEST_CASE("Printing reduces") {
+        std::stringstream printed;
+        printed << LazyFraction(6, -4) << " " << (LazyFraction(1, 6) + LazyFraction(1, 6));
+        CHECK_EQ(printed.str(), "-3/2 1/3");
+        CHECK_EQ((BasicLazyFraction<long long>(2, 4) + 1).getNumerator(), 3);
+    }
+}
+
+TEST_SUITE("Conversions from double") {
+    TEST_CASE("from_double_exact decomposes the IEEE bits") {
+        CHECK_EQ(Fraction::from_double_exact(0.5), Fraction(1, 2));
+        CHECK_EQ(Fraction::from_double_exact(-0.75), Fraction(-3, 4));
+        CHECK_EQ(Fraction::from_double_exact(3.0), Fraction(3, 1));
+        CHECK_EQ(Fraction::from_double_exact(-0.0), Fraction());
+        CHECK_EQ(Fraction::from_double_exact(5e6), Fraction(5000000, 1));
+        CHECK_EQ(Fraction::from_double_exact(-2147483648.0), Fraction(std::numeric_limits<int>::min(), 1));
+        CHECK_EQ(Fraction::from_double_exact(1.0 / 1073741824.0), Fraction(1, 1073741824));
+        CHECK_EQ(Fraction64::from_double_exact(0.1), Fraction64(3602879701896397LL, 36028797018963968LL));
+        CHECK_EQ(Fraction128::from_double_exact(0x1p-126), Fraction128(1, int128_t{1} << 126));
+        static_assert(Fraction::from_double_exact(1.625) == Fraction(13, 8));
+
+        CHECK_THROWS_AS(Fraction::from_double_exact(0.1), std::overflow_error);
+        CHECK_THROWS_AS(Fraction::from_double_exact(2147483648.0), std::overflow_error);
+        CHECK_THROWS_AS(Fraction::from_double_exact(1.0 / 2147483648.0), std::overflow_error);
+        CHECK_THROWS_AS(Fraction::from_double_exact(std::numeric_limits<double>::infinity()), std::invalid_argument);
+        CHECK_THROWS_AS(Fraction::from_double_exact(std::numeric_limits<double>::quiet_NaN()), std::invalid_argument);
+    }
+
+    TEST_CASE("from_double_rounded finds the best approximation") {
+        CHECK_EQ(Fraction::from_double_rounded(0.1), Fraction(1, 10));
+        CHECK_EQ(Fraction::from_double_rounded(0.29, 1000), Fraction(29, 100));
+        CHECK_EQ(Fraction::from_double_rounded(-1.0 / 3.0), Fraction(-1, 3));
+        CHECK_EQ(Fraction::from_double_rounded(3.141592653589793, 10), Fraction(22, 7));
+        CHECK_EQ(Fraction::from_double_rounded(3.141592653589793, 1000), Fraction(355, 113));
+        CHECK_EQ(Fraction::from_double_rounded(3.141592653589793, 57), Fraction(179, 57));
+        CHECK_EQ(Fraction::from_double_rounded(0.7, 1), Fraction(1, 1));
+        CHECK_EQ(Fraction::from_double_rounded(0.5, 1), Fraction(0, 1));
+        CHECK_EQ(Fraction::from_double_rounded(1e-300), Fraction());
+        CHECK_EQ(Fraction::from_double_rounded(2147483647.4, 10), Fraction(std::numeric_limits<int>::max(), 1));
+        CHECK_EQ(Fraction64::from_double_rounded(0.1, 1000000), Fraction64(1, 10));
+        CHECK_EQ(Fraction128::from_double_rounded(1.0 / 7.0, 1000), Fraction128(1, 7));
+        CHECK_EQ(Fraction64::from_double_rounded(0.1), Fraction64::from_double_exact(0.1));
+        static_assert(Fraction::from_double_rounded(0.125, 100) == Fraction(1, 8));
+
+        CHECK_THROWS_AS(Fraction::from_double_rounded(3e9), std::overflow_error);
+        CHECK_THROWS_AS(Fraction::from_double_rounded(0.5, 0), std::invalid_argument);
+        CHECK_THROWS_AS(Fraction::from_double_rounded(std::numeric_limits<double>::infinity()), std::invalid_argument);
+    }
+
+    TEST_CASE("from_double_rounded matches a brute force search") {
+        std::mt19937_64 rng(5);
+        std::uniform_real_distribution<double> values(-10.0, 10.0);
+
+        for (int i = 0; i < 100; i++)
+        {
+            double value = values(rng);
+            const int max_den = 1 + static_cast<int>(rng() % 200);
+            Fraction rounded = Fraction::from_double_rounded(value, max_den);
+            long double best_error = 10;
+
+            for (int den = 1; den <= max_den; den++)
+            {
+                long double num = std::round(static_cast<long double>(value) * den);
+                best_error = std::min(best_error, std::fabs(num / den - static_cast<long double>(value)));
+            }
+
+            long double error = std::fabs(static_cast<long double>(rounded.getNumerator()) / rounded.getDenominator() - static_cast<long double>(value));
+            CHECK_LE(rounded.getDenominator(), max_den);
+            CHECK_LE(error, best_error);
+        }
+    }
+}
+
+TEST_SUITE("Mixed fraction and float kernels") {
+    TEST_CASE("The kernels match the temporary fraction results") {
+        std::mt19937 rng(13);
+        std::uniform_int_distribution<int> numerators(-5000, 5000), denominators(1, 5000);
+        std::uniform_real_distribution<float> floats(-100.0F, 100.0F);
+
+        for (int i = 0; i < 300; i++)
+        {
+            Fraction frac(numerators(rng), denominators(rng));
+            float num = floats(rng);
+            Fraction as_fraction(num);
+
+            CHECK_EQ(frac + num, frac + as_fraction);
+            CHECK_EQ(num + frac, as_fraction + frac);
+            CHECK_EQ(frac - num, frac - as_fraction);
+            CHECK_EQ(num - frac, as_fraction - frac);
+            CHECK_EQ(frac * num, frac * as_fraction);
+            CHECK_EQ(num * frac, as_fraction * frac);
+            CHECK_EQ((frac <=> num), (frac <=> as_fraction));
+            CHECK_EQ(frac == num, frac == as_fraction);
+
+            if (as_fraction != Fraction())
+                CHECK_EQ(frac / num, frac / as_fraction);
+
+            if (frac != Fraction())
+                CHECK_EQ(num / frac, as_fraction / frac);
+        }
+    }
+
+    TEST_CASE("Edge cases") {
+        CHECK_THROWS_AS(Fraction(1, 2) / 0.0004F, std::runtime_error);
+        CHECK_THROWS_AS(0.5F / Fraction(), std::runtime_error);
+        CHECK_EQ(Fraction(1, 3) * -0.0F, Fraction());
+        CHECK_EQ(Fraction(-1, 3) / -0.5F, Fraction(2, 3));
+        CHECK_THROWS_AS(Fraction(std::numeric_limits<int>::max(), 1) + 1.0F, std::overflow_error);
+        CHECK_EQ(Fraction64(6000000000LL, 7) * 0.7F, Fraction64(600000000, 1));
+        CHECK_EQ(Fraction128(1, 3) + 0.5F, Fraction128(5, 6));
+        CHECK_GT(Fraction128(1, 3), 0.333F);
+        static_assert(Fraction(1, 4) + 0.75F == Fraction(1, 1));
+    }
+}
+
+TEST_SUITE("Integer and double operands") {
+    TEST_CASE("Integer operands match integer fractions") {
+        std::mt19937 rng(17);
+        std::uniform_int_distribution<int> numerators(-5000, 5000), denominators(1, 5000), integers(-3000, 3000);
+
+        for (int i = 0; i < 300; i++)
+        {
+            Fraction frac(numerators(rng), denominators(rng));
+            int num = integers(rng);
+            Fraction as_fraction(num, 1);
+
+            CHECK_EQ(frac + num, frac + as_fraction);
+            CHECK_EQ(num + frac, as_fraction + frac);
+            CHECK_EQ(frac - num, frac - as_fraction);
+            CHECK_EQ(num - frac, as_fraction - frac);
+            CHECK_EQ(frac * num, frac * as_fraction);
+            CHECK_EQ(num * frac, as_fraction * frac);
+            CHECK_EQ((frac <=> num), (frac <=> as_fraction));
+            CHECK_EQ((num <=> frac), (as_fraction <=> frac));
+            CHECK_EQ(frac == num, frac == as_fraction);
+
+            if (num != 0)
+                CHECK_EQ(frac / num, frac / as_fraction);
+
+            if (frac != 0)
+                CHECK_EQ(num / frac, as_fraction / frac);
+        }
+    }
+
+    TEST_CASE("Every integer type is accepted") {
+        Fraction frac(1, 2);
+
+        CHECK_EQ(frac + 1L, Fraction(3, 2));
+        CHECK_EQ(frac + 1LL, Fraction(3, 2));
+        CHECK_EQ(frac * 4U, Fraction(2, 1));
+        CHECK_EQ(frac - static_cast<short>(1), Fraction(-1, 2));
+        CHECK_EQ(frac / 2UL, Fraction(1, 4));
+        CHECK_EQ(frac * int128_t{6}, Fraction(3, 1));
+        CHECK_EQ(static_cast<char>(1) - frac, Fraction(1, 2));
+        CHECK_LT(frac, 1ULL);
+        CHECK_EQ(Fraction(4, 2), 2LL);
+    }
+
+    TEST_CASE("Integers beyond the fraction's range") {
+        long long big = 3000000000LL;
+
+        CHECK_EQ(Fraction(-1000000000, 1) + big, Fraction(2000000000, 1));
+        CHECK_EQ(Fraction(2, 3) * big, Fraction(2000000000, 1));
+        CHECK_EQ(Fraction(3, 1) / big, Fraction(1, 1000000000));
+        CHECK_EQ(big / Fraction(3, 2), Fraction(2000000000, 1));
+        CHECK_LT(Fraction(std::numeric_limits<int>::max(), 1), big);
+        CHECK_GT(Fraction(std::numeric_limits<int>::min(), 1), -big * 1000000000LL * 3);
+        CHECK_THROWS_AS(Fraction(1, 2) + big, std::overflow_error);
+        CHECK_THROWS_AS(Fraction(1, 3) / big, std::overflow_error);
+        CHECK_THROWS_AS(Fraction(1, 2) * std::numeric_limits<unsigned long long>::max(), std::overflow_error);
+        CHECK_THROWS_AS(Fraction(1, 2) / 0, std::runtime_error);
+        CHECK_THROWS_AS(1 / Fraction(), std::runtime_error);
+        CHECK_EQ(SaturatingFraction(1, 2) + big, SaturatingFraction(std::numeric_limits<int>::max(), 1));
+        overflow::clear();
+    }
+
+    TEST_CASE("Double operands are rounded to 3 decimals") {
+        Fraction frac(1, 3);
+
+        CHECK_EQ(2.3 * frac, Fraction(23, 30));
+        CHECK_EQ(frac + 0.29, Fraction(187, 300));
+        CHECK_EQ(frac - 0.29, Fraction(13, 300));
+        CHECK_EQ(0.29 - frac, Fraction(-13, 300));
+        CHECK_EQ(frac / 0.29, Fraction(100, 87));
+        CHECK_EQ(0.29 / frac, Fraction(87, 100));
+        CHECK_EQ(Fraction(-29, 100), -0.29);
+        CHECK_GT(frac, 0.333);
+        CHECK_LT(frac, 0.3336);
+        CHECK_GT(frac, 0.3334);
+        CHECK_EQ(Fraction(3000000, 1) + 0.5L, Fraction(6000001, 2));
+        CHECK_THROWS_AS(frac / 0.0004, std::runtime_error);
+        CHECK_THROWS_AS(frac + 3e6, std::overflow_error);
+        CHECK_THROWS_AS(frac + std::numeric_limits<double>::quiet_NaN(), std::overflow_error);
+        static_assert(Fraction(1, 2) + 1 == Fraction(3, 2));
+        static_assert(2.3 * Fraction(1, 3) == Fraction(23, 30));
+    }
+
+    TEST_CASE("Floats and doubles share one rounding rule") {
+        int mismatches = 0;
+
+        for (int i = -100000; i <= 100000; i++)
+        {
+            const double number = i / 997.0;
+            mismatches += (Fraction(number) != number) + (Fraction64(number) != number) + (Fraction(static_cast<float>(number)) != static_cast<float>(number));
+        }
+
+        CHECK_EQ(mismatches, 0);
+        CHECK_EQ(Fraction(-100.300903), -100.300903);
+        CHECK_EQ(Fraction(-100.300903), Fraction(-100301, 1000));
+        CHECK_EQ(Fraction(2.3f), Fraction(2.3));
+        CHECK_EQ(Fraction(23, 10), 2.3f);
+        CHECK_EQ(Fraction(1, 3) + 2.3f, Fraction(1, 3) + 2.3);
+        CHECK_EQ(Fraction(1, 3) * 2.3f, Fraction(1, 3) * 2.3);
+        CHECK_EQ(Fraction(0.0004), Fraction());
+        CHECK_EQ(Fraction(0.0005), Fraction(1, 1000));
+        CHECK_EQ(Fraction(-0.0005), Fraction(-1, 1000));
+        CHECK_THROWS_AS(Fraction(3e6), std::overflow_error);
+        CHECK_LT(Fraction(1, 2), 3e6f);
+    }
+
+    TEST_CASE("Comparisons with scalars beyond the fraction's range don't overflow") {
+        unsigned long long max_ull = std::numeric_limits<unsigned long long>::max();
+        int128_t huge = int128_t{1} << 100;
+        double inf = std::numeric_limits<double>::infinity();
+
+        CHECK_NE(Fraction(1, 1), max_ull);
+        CHECK_LT(Fraction(1, 1), max_ull);
+        CHECK_LT(Fraction(std::numeric_limits<int>::max(), 1), max_ull);
+        CHECK_LT(Fraction(1, 1), huge);
+        CHECK_GT(Fraction(1, 1), -huge);
+        CHECK_NE(Fraction(1, 1), huge);
+        CHECK_LT(Fraction64(std::numeric_limits<std::int64_t>::max(), 1), huge);
+        CHECK_LT(Fraction128(1, 1), huge + 1);
+        CHECK_GT(FlaggingFraction(1, 1), -huge);
+        CHECK_FALSE(overflow::occurred());
+
+        CHECK_LT(Fraction(1, 2), 3e6);
+        CHECK_LT(Fraction(1, 2), 1e300);
+        CHECK_GT(Fraction(1, 2), -1e300);
+        CHECK_LT(Fraction(1, 2), inf);
+        CHECK_GT(Fraction(std::numeric_limits<int>::min(), 1), -inf);
+        CHECK_NE(Fraction(1, 2), 3e6);
+        CHECK_GT(Fraction(3000001, 1), 3e6);
+        CHECK_EQ(Fraction(6000001, 2), 3000000.5);
+        CHECK_GT(Fraction(std::numeric_limits<int>::max(), 1), 2147483646.9994);
+        CHECK_LT(Fraction(std::numeric_limits<int>::max(), 1), 2147483647.0006);
+        CHECK_EQ(Fraction64(std::numeric_limits<std::int64_t>::max() - 1023, 1), 0x1p63 - 1024);
+        CHECK_LT(Fraction64(std::numeric_limits<std::int64_t>::max(), 1), 0x1p63);
+        CHECK_LT(Fraction128(1, 3), 1e30);
+        CHECK_GT(Fraction128(huge, 1), 1e30);
+        CHECK_EQ(Fraction128(-1, 8), -0.125);
+        CHECK_LT(Fraction128(-1, 8), -0.124);
+        CHECK_GT(Fraction128(-1, 8), -0.126);
+        CHECK_THROWS_AS((void)(Fraction(1, 2) < std::numeric_limits<double>::quiet_NaN()), std::invalid_argument);
+    }
+}
+
+/*
+ * @brief The distance between num / den and value, scaled by den * 2^scale (so it is an integer).
+*/
+template <typename FloatT>
+BigInt scaled_distance(const BigInt& num, const BigInt& den, FloatT value, int scale) {
+    int exponent = 0;
+    const auto mantissa = static_cast<long long>(std::ldexp(std::frexp(value, &exponent), std::numeric_limits<FloatT>::digits));
+    BigInt left = num, right = BigInt(mantissa) * den;
+
+    for (int i = 0; i < scale; i++)
+        left = left * BigInt(2);
+
+    for (int i = 0; i < exponent - std::numeric_limits<FloatT>::digits + scale; i++)
+        right = right * BigInt(2);
+
+    return (left - right).abs();
+}
+
+/*
+ * @brief Checks that value is the nearest FloatT to num / den (ties to even), against both neighbours.
+*/
+template <typename FloatT>
+bool is_correctly_rounded(const BigInt& num, const BigInt& den, FloatT value) {
+    const FloatT below = std::nextafter(value, -std::numeric_limits<FloatT>::infinity());
+    const FloatT above = std::nextafter(value, std::numeric_limits<FloatT>::infinity());
+    const int scale = 2 * std::numeric_limits<FloatT>::digits - std::min(std::ilogb(below), 0);
+    const BigInt distance = scaled_distance(num, den, value, scale);
+    int exponent = 0;
+    const auto mantissa = static_cast<long long>(std::ldexp(std::frexp(value, &exponent), std::numeric_limits<FloatT>::digits));
+
+    for (FloatT neighbour : {below, above})
+    {
+        const BigInt other = scaled_distance(num, den, neighbour, scale);
+
+        if (other < distance)
+            return false;
+
+        // A tie must go to the even mantissa.
+        if (other == distance && mantissa % 2 != 0)
+            return false;
+    }
+
+    return true;
+}
+
+TEST_SUITE("Conversions to floating point") {
+    TEST_CASE("Int fractions take a single division") {
+        std::mt19937 rng(15);
+        std::uniform_int_distribution<int> numerators(std::numeric_limits<int>::min() + 1, std::numeric_limits<int>::max()), denominators(1, std::numeric_limits<int>::max());
+
+        for (int i = 0; i < 1000; i++)
+        {
+            Fraction frac(numerators(rng), denominators(rng));
+
+            CHECK_EQ(frac.to_double(), static_cast<double>(frac.getNumerator()) / static_cast<double>(frac.getDenominator()));
+            CHECK(is_correctly_rounded(BigInt(frac.getNumerator()), BigInt(frac.getDenominator()), frac.to_float()));
+        }
+
+        CHECK_FALSE(is_correctly_rounded(BigInt(1), BigInt(3), std::nextafter(1.0 / 3, 1.0)));
+        CHECK_FALSE(is_correctly_rounded(BigInt(1), BigInt(3), std::nextafter(1.0F / 3, 0.0F)));
+        CHECK_EQ(Fraction().to_double(), 0.0);
+        CHECK_EQ(Fraction(-3, 4).to_float(), -0.75F);
+        CHECK_EQ(Fraction(std::numeric_limits<int>::min(), 1).to_double(), -2147483648.0);
+        static_assert(Fraction(1, 4).to_double() == 0.25);
+    }
+
+    TEST_CASE("Wide fractions are correctly rounded") {
+        std::mt19937_64 rng(15);
+
+        for (int i = 0; i < 1000; i++)
+        {
+            const auto num = static_cast<std::int64_t>(rng() >> (i % 64)) * ((i % 3 == 0) ? -1 : 1);
+            const auto den = static_cast<std::int64_t>((rng() >> (1 + (i * 7) % 63)) | 1);
+            Fraction64 frac(num, den);
+
+            CHECK(is_correctly_rounded(BigInt(frac.getNumerator()), BigInt(frac.getDenominator()), frac.to_double()));
+            CHECK(is_correctly_rounded(BigInt(frac.getNumerator()), BigInt(frac.getDenominator()), frac.to_float()));
+        }
+
+        for (int i = 0; i < 300; i++)
+        {
+            const auto num = static_cast<int128_t>((static_cast<uint128_t>(rng()) << 64 | rng()) >> (1 + i % 120));
+            const auto den = static_cast<int128_t>((static_cast<uint128_t>(rng()) << 64 | rng()) >> (1 + (i * 13) % 127)) | 1;
+            Fraction128 frac(num, den);
+
+            CHECK(is_correctly_rounded(BigInt(frac.getNumerator()), BigInt(frac.getDenominator()), frac.to_double()));
+            CHECK(is_correctly_rounded(BigInt(frac.getNumerator()), BigInt(frac.getDenominator()), frac.to_float()));
+        }
+    }
+
+    TEST_CASE("Ties, extremes and subnormals") {
+        constexpr std::int64_t two_54 = std::int64_t{1} << 54;
+
+        // Half way between representable doubles (4 apart above 2^54): ties go to the even mantissa.
+        CHECK_EQ(Fraction64(two_54 + 2, 1).to_double(), static_cast<double>(two_54));
+        CHECK_EQ(Fraction64(two_54 + 6, 1).to_double(), static_cast<double>(two_54 + 8));
+        CHECK_EQ(Fraction64(two_54 + 3, 1).to_double(), static_cast<double>(two_54 + 4));
+        CHECK_EQ(Fraction64(-two_54 - 6, 1).to_double(), -static_cast<double>(two_54 + 8));
+        CHECK_EQ(Fraction64(1, two_54 + 1).to_double(), 1.0 / static_cast<double>(two_54));
+        CHECK_EQ(Fraction64(std::numeric_limits<std::int64_t>::max(), 1).to_double(), std::ldexp(1.0, 63));
+        CHECK_EQ(Fraction64(std::numeric_limits<std::int64_t>::min(), 3).to_double(), std::ldexp(-1.0, 63) / 3);
+        CHECK_EQ(Fraction128(std::numeric_limits<int128_t>::min(), 1).to_double(), std::ldexp(-1.0, 127));
+        CHECK_EQ(Fraction128(std::numeric_limits<int128_t>::min(), std::numeric_limits<int128_t>::max()).to_float(), -1.0F);
+
+        // 1 / (2^127 - 1) is just above 2^-127, a subnormal float.
+        CHECK_EQ(Fraction128(1, std::numeric_limits<int128_t>::max()).to_float(), std::ldexp(1.0F, -127));
+        CHECK_EQ(Fraction128(3, std::numeric_limits<int128_t>::max()).to_float(), std::ldexp(3.0F, -127));
+        static_assert(Fraction64(two_54 + 6, 1).to_double() == static_cast<double>(two_54 + 8));
+    }
+
+    TEST_CASE("Bulk conversions") {
+        std::mt19937_64 rng(16);
+        std::vector<Fraction64> fractions;
+
+        for (int i = 0; i < 500; i++)
+            fractions.emplace_back(static_cast<std::int64_t>(rng() >> (i % 64)) - (1LL << 40), static_cast<std::int64_t>(rng() >> (1 + i % 63)) | 1);
+
+        std::vector<double> doubles(fractions.size());
+        std::vector<float> floats(fractions.size());
+        Fraction64::to_double(fractions, doubles);
+        Fraction64::to_float(fractions, floats);
+
+        for (std::size_t i = 0; i < fractions.size(); i++)
+        {
+            CHECK_EQ(doubles[i], fractions[i].to_double());
+            CHECK_EQ(floats[i], fractions[i].to_float());
+        }
+
+        std::vector<Fraction> small = {Fraction(1, 2), Fraction(-1, 3), Fraction(7, 1)};
+        std::vector<double> results(small.size());
+        Fraction::to_double(small, results);
+
+        CHECK_EQ(results, std::vector<double>{0.5, -1.0 / 3, 7.0});
+        CHECK_THROWS_AS(Fraction::to_double(small, std::span<double>(results).first(2)), std::invalid_argument);
+    }
+}
+
+TEST_SUITE("Hashing and flat hash tables") {
+    TEST_CASE("Equal fractions have equal hashes") {
+        std::hash<Fraction> hash;
+
+        CHECK_EQ(hash(Fraction(1, 2)), hash(Fraction(2, 4)));
+        CHECK_EQ(hash(Fraction(-3, 6)), hash(Fraction(1, -2)));
+        CHECK_NE(hash(Fraction(1, 2)), hash(Fraction(2, 1)));
+        CHECK_NE(hash(Fraction(1, 2)), hash(Fraction(-1, 2)));
+        CHECK_EQ(std::hash<Fraction128>{}(Fraction128(6, 4)), std::hash<Fraction128>{}(Fraction128(3, 2)));
+        CHECK_NE(std::hash<Fraction64>{}(Fraction64(1, 3)), std::hash<Fraction64>{}(Fraction64(3, 1)));
+
+        // Int fractions never collide, and nearby values spread over the low bits too.
+        std::unordered_set<std::size_t> hashes, buckets;
+        std::size_t count = 0;
+
+        for (int num = -50; num <= 50; num++)
+        {
+            for (int den = 1; den <= 50; den++)
+            {
+                if (std::gcd(num, den) == 1)
+                {
+                    count++;
+                    hashes.insert(hash(Fraction(num, den)));
+                    buckets.insert(hash(Fraction(num, den)) & 1023);
+                }
+            }
+        }
+
+        CHECK_EQ(hashes.size(), count);
+        CHECK_GT(buckets.size(), 900);
+
+        std::unordered_set<Fraction> values = {Fraction(1, 2), Fraction(2, 4), Fraction(3, 4)};
+        CHECK_EQ(values.size(), 2);
+    }
+
+    TEST_CASE("FlatHashMap matches std::map") {
+        std::mt19937 rng(16);
+        std::uniform_int_distribution<int> numerators(-40, 40), denominators(1, 40), operations(0, 3);
+        FlatHashMap<Fraction, int> flat;
+        std::map<Fraction, int> reference;
+
+        for (int i = 0; i < 20000; i++)
+        {
+            Fraction key(numerators(rng), denominators(rng));
+
+            switch (operations(rng))
+            {
+                case 0:
+                case 1:
+                    flat[key] += i;
+                    reference[key] += i;
+                    break;
+
+                case 2:
+                    CHECK_EQ(flat.erase(key), reference.erase(key) == 1);
+                    break;
+
+                default:
+                    CHECK_EQ(flat.insert(key, -i), reference.emplace(key, -i).second);
+                    break;
+            }
+        }
+
+        CHECK_EQ(flat.size(), reference.size());
+
+        std::size_t visited = 0;
+        flat.for_each([&](const Fraction& key, int value) {
+            CHECK_EQ(reference.at(key), value);
+            visited++;
+        });
+
+        CHECK_EQ(visited, reference.size());
+
+        for (const auto& [key, value] : reference)
+        {
+            REQUIRE(flat.find(key) != nullptr);
+            CHECK_EQ(*flat.find(key), value);
+        }
+
+        CHECK_EQ(flat.find(Fraction(41, 1)), nullptr);
+        flat.clear();
+        CHECK(flat.empty());
+        CHECK_FALSE(flat.contains(reference.begin()->first));
+    }
+
+    TEST_CASE("FlatHashSet") {
+        FlatHashSet<Fraction64> set;
+
+        CHECK_FALSE(set.contains(Fraction64(1, 2)));
+        CHECK_FALSE(set.erase(Fraction64(1, 2)));
+
+        set.reserve(1000);
+        const std::size_t capacity = set.capacity();
+
+        for (long long i = 1; i <= 1000; i++)
+        {
+            CHECK(set.insert(Fraction64(i, 3)));
+            CHECK_FALSE(set.insert(Fraction64(2 * i, 6)));
+        }
+
+        CHECK_EQ(set.size(), 1000);
+        CHECK_EQ(set.capacity(), capacity);
+
+        for (long long i = 1; i <= 1000; i += 2)
+            CHECK(set.erase(Fraction64(i, 3)));
+
+        for (long long i = 1; i <= 1000; i++)
+            CHECK_EQ(set.contains(Fraction64(i, 3)), i % 2 == 0);
+
+        // A zero numerator is a valid key, only the denominator marks the empty slots.
+        CHECK(set.insert(Fraction64()));
+        CHECK(set.contains(Fraction64(0, 5)));
+        CHECK_EQ(set.size(), 501);
+    }
+}
+
+TEST_SUITE("Fused multiply-add and accumulation") {
+    TEST_CASE("fma matches the operators") {
+        std::mt19937 rng(17);
+        std::uniform_int_distribution<int> numerators(-50000, 50000), denominators(1, 50000);
+
+        for (int i = 0; i < 1000; i++)
+        {
+            Fraction num1(numerators(rng), denominators(rng)), num2(numerators(rng), denominators(rng)), num3(numerators(rng), denominators(rng));
+            Fraction64 wide1(num1.getNumerator(), num1.getDenominator()), wide2(num2.getNumerator(), num2.getDenominator()), wide3(num3.getNumerator(), num3.getDenominator());
+            Fraction64 expected = wide1 * wide2 + wide3;
+
+            if (std::max(std::abs(expected.getNumerator()), expected.getDenominator()) <= std::numeric_limits<int>::max())
+                CHECK_EQ(Fraction::fma(num1, num2, num3), Fraction(static_cast<int>(expected.getNumerator()), static_cast<int>(expected.getDenominator())));
+
+            else
+                CHECK_THROWS_AS(Fraction::fma(num1, num2, num3), std::overflow_error);
+
+            CHECK_EQ(Fraction64::fma(wide1, wide2, wide3), expected);
+        }
+
+        // The product alone overflows, but the sum fits again.
+        const int max_int = std::numeric_limits<int>::max();
+        CHECK_EQ(Fraction::fma(Fraction(max_int, 1), Fraction(2, 1), Fraction(-max_int, 1)), Fraction(max_int, 1));
+        CHECK_THROWS_AS(Fraction(max_int, 1) * Fraction(2, 1) + Fraction(-max_int, 1), std::overflow_error);
+
+        // More than 128 bits, through the regular operators.
+        const long long max_long = std::numeric_limits<long long>::max();
+        CHECK_EQ(Fraction64::fma(Fraction64(max_long, max_long - 1), Fraction64(max_long - 1, max_long), Fraction64(1, max_long - 2)),
+            Fraction64(max_long - 1, max_long - 2));
+        CHECK_EQ(Fraction128::fma(Fraction128(3, 4), Fraction128(2, 3), Fraction128(1, 2)), Fraction128(1, 1));
+        CHECK_EQ(SaturatingFraction::fma(SaturatingFraction(max_int, 1), SaturatingFraction(max_int, 1), SaturatingFraction()), SaturatingFraction(max_int, 1));
+        overflow::clear();
+
+        static_assert(Fraction::fma(Fraction(1, 2), Fraction(2, 3), Fraction(-1, 3)) == Fraction());
+    }
+
+    TEST_CASE("Dot products match the operators") {
+        std::mt19937 rng(17);
+        std::uniform_int_distribution<int> weights(0, 100), prices(1, 1000), denominators(1, 6);
+        std::vector<Fraction> first, second;
+        Fraction128 expected;
+
+        // Small denominators (like money), the unreduced sum still nears 128 bits every dozen or so terms.
+        for (int i = 0; i < 1000; i++)
+        {
+            first.emplace_back(weights(rng), 100);
+            second.emplace_back(prices(rng), denominators(rng));
+            expected = expected + Fraction128(first.back().getNumerator(), first.back().getDenominator()) * Fraction128(second.back().getNumerator(), second.back().getDenominator());
+        }
+
+        const Fraction dot = FractionAccumulator::dot(first, second);
+        CHECK_EQ(Fraction128(dot.getNumerator(), dot.getDenominator()), expected);
+
+        BasicFractionAccumulator<std::int64_t> accumulator;
+        Fraction64 sum;
+
+        for (std::size_t i = 0; i < first.size(); i++)
+        {
+            Fraction64 term(second[i].getNumerator(), second[i].getDenominator());
+            accumulator.add(term);
+            accumulator += term;
+            sum = sum + term + term;
+        }
+
+        CHECK_EQ(accumulator.result(), sum);
+        accumulator.reset();
+        CHECK_EQ(accumulator.result(), Fraction64());
+
+        CHECK_THROWS_AS(FractionAccumulator::dot(first, std::span<const Fraction>(second).first(3)), std::invalid_argument);
+    }
+
+    TEST_CASE("Sums that don't fit") {
+        // Distinct large prime denominators: the least common multiple outgrows 128 bits.
+        const int primes[] = {2147483647, 2147483629, 2147483587, 2147483579, 2147483563};
+        FractionAccumulator accumulator;
+
+        CHECK_THROWS_AS(
+            for (int prime : primes)
+                accumulator.add(Fraction(1, prime)),
+            std::overflow_error);
+
+        // The 128-bit sum fits, the int result doesn't.
+        FractionAccumulator big;
+        big.add(Fraction(std::numeric_limits<int>::max(), 1));
+        big.add(Fraction(1, 1));
+        CHECK_THROWS_AS(big.result(), std::overflow_error);
+        big.add(Fraction(-2, 1));
+        CHECK_EQ(big.result(), Fraction(std::numeric_limits<int>::max() - 1, 1));
+    }
+}
+
+TEST_SUITE("Compound assignment operators") {
+    TEST_CASE("Match the binary operators") {
+        std::mt19937 rng(18);
+        std::uniform_int_distribution<int> numerators(-1000, 1000), denominators(1, 1000);
+
+        for (int i = 0; i < 300; i++)
+        {
+            const Fraction frac(numerators(rng), denominators(rng));
+            Fraction other(numerators(rng), denominators(rng));
+            const int integer = numerators(rng) / 10;
+            const float single = static_cast<float>(integer) / 8;
+            const double value = static_cast<double>(integer) / 4;
+
+            if (other == 0)
+                other = Fraction(1, 3);
+
+            Fraction result = frac;
+            CHECK_EQ(result += other, frac + other);
+            result = frac;
+            CHECK_EQ(result -= other, frac - other);
+            result = frac;
+            CHECK_EQ(result *= other, frac * other);
+            result = frac;
+            CHECK_EQ(result /= other, frac / other);
+
+            result = frac;
+            CHECK_EQ(result += single, frac + single);
+            result = frac;
+            CHECK_EQ(result -= integer, frac - integer);
+            result = frac;
+            CHECK_EQ(result *= value, frac * value);
+            result = frac;
+            CHECK_EQ(result *= 3LL, frac * 3LL);
+
+            if (integer != 0)
+            {
+                result = frac;
+                CHECK_EQ(result /= integer, frac / integer);
+                result = frac;
+                CHECK_EQ(result /= single, frac / single);
+            }
+        }
+    }
+
+    TEST_CASE("Aliasing, chaining and failures") {
+        Fraction frac(3, 4);
+
+        frac += frac;
+        CHECK_EQ(frac, Fraction(3, 2));
+        frac *= frac;
+        CHECK_EQ(frac, Fraction(9, 4));
+        frac /= frac;
+        CHECK_EQ(frac, Fraction(1, 1));
+        frac -= frac;
+        CHECK_EQ(frac, Fraction());
+
+        Fraction chained(1, 2);
+        ((chained += 1) *= 2) -= Fraction(1, 3);
+        CHECK_EQ(chained, Fraction(8, 3));
+
+        // A failed operation leaves the fraction unchanged.
+        Fraction big(std::numeric_limits<int>::max(), 1);
+        CHECK_THROWS_AS(big += 1, std::overflow_error);
+        CHECK_THROWS_AS(big /= Fraction(), std::runtime_error);
+        CHECK_EQ(big, Fraction(std::numeric_limits<int>::max(), 1));
+
+        constexpr Fraction sum = [] {
+            Fraction result;
+
+            for (int i = 1; i <= 4; i++)
+                result += Fraction(1, i * (i + 1));
+
+            return result;
+        }();
+
+        static_assert(sum == Fraction(4, 5));
+    }
+}
+
+TEST_SUITE("Trusted construction") {
+    TEST_CASE("Increment and decrement skip the reduction") {
+        Fraction frac(7, 3);
+
+        CHECK_EQ(++frac, Fraction(10, 3));
+        CHECK_EQ(frac++, Fraction(10, 3));
+        CHECK_EQ(frac, Fraction(13, 3));
+        CHECK_EQ(--frac, Fraction(10, 3));
+        CHECK_EQ(frac--, Fraction(10, 3));
+        CHECK_EQ(frac.getNumerator(), 7);
+        CHECK_EQ(frac.getDenominator(), 3);
+
+        Fraction negative(-1, 2);
+        CHECK_EQ(++negative, Fraction(1, 2));
+        CHECK_EQ(--(--negative), Fraction(-3, 2));
+
+        // The increment is overflow checked now, a failure leaves the fraction unchanged.
+        Fraction max(std::numeric_limits<int>::max(), 1);
+        CHECK_THROWS_AS(++max, std::overflow_error);
+        CHECK_EQ(max, Fraction(std::numeric_limits<int>::max(), 1));
+
+        Fraction min(std::numeric_limits<int>::min() + 1, 2);
+        CHECK_THROWS_AS(--min, std::overflow_error);
+
+        SaturatingFraction saturating(std::numeric_limits<int>::max() - 1, 1);
+        CHECK_EQ(++(++saturating), SaturatingFraction(std::numeric_limits<int>::max(), 1));
+        CHECK(overflow::occurred());
+        overflow::clear();
+
+        static_assert(++Fraction(1, 2) == Fraction(3, 2));
+    }
+
+    TEST_CASE("Reduced parts are handed over as they are") {
+        LazyFraction lazy = LazyFraction(1, 6) + LazyFraction(1, 6);
+        CHECK_EQ(lazy.to_fraction(), Fraction(1, 3));
+
+        BigFraction big(2, 8);
+        CHECK_EQ(big.to_fraction(), Fraction(1, 4));
+    }
+}
+
+TEST_SUITE("Trivially copyable fractions") {
+    TEST_CASE("Type traits") {
+        CHECK(std::is_trivially_copyable_v<Fraction>);
+        CHECK(std::is_trivially_copy_assignable_v<Fraction64>);
+        CHECK(std::is_trivially_move_constructible_v<Fraction128>);
+        CHECK(std::is_trivially_destructible_v<SaturatingFraction>);
+        CHECK(std::is_standard_layout_v<FlaggingFraction>);
+        CHECK(std::is_nothrow_move_assignable_v<Fraction>);
+        CHECK_EQ(sizeof(Fraction64), 2 * sizeof(std::int64_t));
+    }
+
+    TEST_CASE("Copies through memcpy and self assignment") {
+        const Fraction source[] = {Fraction(1, 2), Fraction(-3, 4), Fraction(5, 1)};
+        Fraction target[3];
+
+        std::memcpy(static_cast<void*>(target), static_cast<const void*>(source), sizeof(source));
+        CHECK(std::equal(std::begin(source), std::end(source), std::begin(target)));
+
+        Fraction frac(7, 9);
+        Fraction& alias = frac;
+        frac = alias;
+        frac = std::move(alias);
+        CHECK_EQ(frac, Fraction(7, 9));
+
+        std::vector<Fraction> fractions(1000, Fraction(1, 3));
+        fractions.resize(5000, Fraction(2, 3));
+        std::vector<Fraction> copy(fractions.size());
+        std::copy(fractions.begin(), fractions.end(), copy.begin());
+        CHECK_EQ(copy, fractions);
+        CHECK_EQ(copy.back(), Fraction(2, 3));
+    }
+}
+
+/*
+ * @brief Runs a test body under every instruction set the CPU supports, then restores the selected one.
+*/
+template <typename Body>
+static void for_each_isa(Body body) {
+    const FractionArray::Isa selected = FractionArray::isa();
+
+    for (const auto isa : {FractionArray::Isa::Scalar, FractionArray::Isa::AVX2, FractionArray::Isa::AVX512})
+    {
+        if (!FractionArray::supports(isa))
+            continue;
+
+        CAPTURE(static_cast<int>(isa));
+        FractionArray::set_isa(isa);
+        body();
+    }
+
+    FractionArray::set_isa(selected);
+}
+
+TEST_SUITE("Structure of arrays") {
+    TEST_CASE("Storage") {
+        FractionArray array(3);
+        CHECK_EQ(array.size(), 3);
+        CHECK_EQ(array[1], Fraction(0, 1));
+
+        array.set(1, Fraction(-6, 8));
+        array.push_back(Fraction(5, 10));
+        CHECK_EQ(array[1], Fraction(-3, 4));
+        CHECK_EQ(array.size(), 4);
+        CHECK_EQ(array.to_vector(), vector<Fraction>{Fraction(0, 1), Fraction(-3, 4), Fraction(0, 1), Fraction(1, 2)});
+        CHECK_EQ(reinterpret_cast<std::uintptr_t>(array.numerators().data()) % FractionArray::alignment, 0);
+        CHECK_EQ(reinterpret_cast<std::uintptr_t>(array.denominators().data()) % FractionArray::alignment, 0);
+
+        array.resize(2);
+        CHECK_EQ(array, FractionArray(vector<Fraction>{Fraction(0, 1), Fraction(-3, 4)}));
+        CHECK_THROWS_AS(FractionArray::add(array, FractionArray(3), array), invalid_argument);
+
+        vector<std::int8_t> signs(1);
+        CHECK_THROWS_AS(FractionArray::compare(array, array, signs), invalid_argument);
+        CHECK_THROWS_AS(FractionArray::set_isa(static_cast<FractionArray::Isa>(3)), invalid_argument);
+    }
+
+    TEST_CASE("Every kernel matches the scalar operators") {
+        std::mt19937 rng(21);
+        uniform_int_distribution<int> small(-500, 500), positive(1, 500), any(numeric_limits<int>::min() / 2, numeric_limits<int>::max() / 2);
+        vector<Fraction> lhs, rhs;
+
+        // Small parts never overflow, 1003 pairs cover several blocks and the SIMD tails.
+        for (int i = 0; i < 1003; i++)
+        {
+            lhs.emplace_back(small(rng), positive(rng));
+            rhs.emplace_back(small(rng), positive(rng));
+        }
+
+        // Large parts: common denominators, reciprocals, equal and unrelated operands.
+        for (int i = 0; i < 1003; i++)
+        {
+            const Fraction num1(any(rng) | 1, (i % 3 == 0) ? 1 : any(rng) | 1);
+            lhs.push_back(num1);
+
+            if (i % 4 == 0)
+                rhs.emplace_back(any(rng), num1.getDenominator());
+
+            else if (i % 4 == 1)
+                rhs.emplace_back(num1.getDenominator(), num1.getNumerator());
+
+            else
+                rhs.push_back((i % 4 == 2) ? num1 : Fraction(any(rng), any(rng) | 1));
+        }
+
+        rhs[8] = Fraction(0, 1) - lhs[8];
+        lhs[9] = Fraction(0, 1);
+
+        for_each_isa([&]() {
+            vector<std::int8_t> signs(lhs.size());
+            FractionArray::compare(FractionArray(lhs), FractionArray(rhs), signs);
+
+            for (size_t i = 0; i < lhs.size(); i++)
+                CHECK_EQ(signs[i], static_cast<std::int8_t>((lhs[i] > rhs[i]) - (lhs[i] < rhs[i])));
+
+            for (const auto operation : {&FractionArray::add, &FractionArray::sub, &FractionArray::mul, &FractionArray::div})
+            {
+                // Only the pairs whose scalar result fits are kept, so the batch doesn't throw.
+                vector<Fraction> first, second, expected;
+
+                for (size_t i = 0; i < lhs.size(); i++)
+                {
+                    try
+                    {
+                        expected.push_back((operation == &FractionArray::add) ? lhs[i] + rhs[i] : (operation == &FractionArray::sub) ? lhs[i] - rhs[i]
+                                         : (operation == &FractionArray::mul) ? lhs[i] * rhs[i] : lhs[i] / rhs[i]);
+                        first.push_back(lhs[i]);
+                        second.push_back(rhs[i]);
+                    }
+                    catch (const exception&) {}
+                }
+
+                CHECK_GT(first.size(), 1200);
+                FractionArray result;
+                operation(FractionArray(first), FractionArray(second), result);
+                CHECK_EQ(result.to_vector(), expected);
+
+                FractionArray aliased(first);
+                operation(aliased, FractionArray(second), aliased);
+                CHECK_EQ(aliased, result);
+            }
+        });
+    }
+
+    TEST_CASE("Errors match the scalar operators") {
+        const int max = numeric_limits<int>::max();
+        FractionArray lhs(100), rhs(100);
+
+        for (size_t i = 0; i < 100; i++)
+        {
+            lhs.set(i, Fraction(static_cast<int>(i), 7));
+            rhs.set(i, Fraction(1, 3));
+        }
+
+        for_each_isa([&]() {
+            FractionArray overflowing = lhs;
+            overflowing.set(61, Fraction(max, 1));
+            CHECK_THROWS_WITH_AS(overflowing * FractionArray(vector<Fraction>(100, Fraction(2, 1))), "Fraction overflow", overflow_error);
+            CHECK_THROWS_WITH_AS(overflowing + FractionArray(vector<Fraction>(100, Fraction(1, 1))), "Fraction overflow", overflow_error);
+            CHECK_THROWS_WITH_AS(lhs / lhs, "Can't divide by zero", runtime_error);
+
+            // Only the first element's parts leave int, its reduced result fits.
+            FractionArray reducible(vector<Fraction>{Fraction(max, 2)}), halves(vector<Fraction>{Fraction(1, 2)});
+            CHECK_EQ((reducible + reducible)[0], Fraction(max, 1));
+            CHECK_EQ((reducible / halves)[0], Fraction(max, 1));
+            CHECK_EQ((lhs - rhs)[99], Fraction(290, 21));
+        });
+    }
+}
+
+TEST_SUITE("Lane-parallel gcd") {
+    TEST_CASE("Bulk normalization matches the constructor") {
+        const int min = numeric_limits<int>::min(), max = numeric_limits<int>::max();
+        std::mt19937 rng(22);
+        uniform_int_distribution<int> any(min, max), half(min / 2, max / 2), exponent(0, 11);
+        vector<int> numerators{0, 1, -1, max, min, 1836311903, 1 << 30, 6, -6, 7, 12, min, 0, max};
+        vector<int> denominators{5, 1, -1, -1, max, 1134903170, 1 << 20, -4, 9, 7, 12, 2, -3, max};
+
+        for (int i = 0; i < 3000; i++)
+        {
+            // Shared powers of 2 and common factors, so the gcds are rarely 1.
+            const int factor = 1 << exponent(rng);
+            numerators.push_back((i % 2 == 0) ? any(rng) : any(rng) / factor * factor);
+            denominators.push_back((i % 3 == 0) ? (any(rng) | 1) : half(rng) / (factor * 7) * (factor * 7) + factor);
+        }
+
+        for_each_isa([&]() {
+            const FractionArray fractions = FractionArray::from_parts(numerators, denominators);
+            REQUIRE_EQ(fractions.size(), numerators.size());
+
+            for (size_t i = 0; i < numerators.size(); i++)
+            {
+                CAPTURE(i);
+                CHECK_EQ(fractions[i], Fraction(numerators[i], denominators[i]));
+                CHECK_EQ(fractions.denominators()[i], Fraction(numerators[i], denominators[i]).getDenominator());
+            }
+
+            CHECK_THROWS_AS(FractionArray::from_parts(vector<int>{1, 2}, vector<int>{3, 0}), invalid_argument);
+            CHECK_THROWS_AS(FractionArray::from_parts(vector<int>{1, 2}, vector<int>{3}), invalid_argument);
+
+            // INT_MIN parts, which the wide kernels and the constructor reduce before fixing the sign.
+            const FractionArray extremes = FractionArray::from_parts(vector<int>{min, min, min, 4, 0}, vector<int>{-10, min, 1, min, min});
+            CHECK_EQ(extremes.to_vector(), vector<Fraction>{Fraction(1073741824, 5), Fraction(1, 1), Fraction(min, 1), Fraction(-1, 536870912), Fraction(0, 1)});
+            CHECK_THROWS_AS(FractionArray::from_parts(vector<int>{1, 3}, vector<int>{2, min}), overflow_error);
+            CHECK_THROWS_AS(FractionArray::from_parts(vector<int>{min}, vector<int>{-1}), overflow_error);
+        });
+    }
+
+    TEST_CASE("Arithmetic with large common factors") {
+        const FractionArray lhs(vector<Fraction>(600, Fraction(1 << 20, 3 * 5 * 7 * 11 * 13)));
+        const FractionArray rhs(vector<Fraction>(600, Fraction(3 * 5 * 7 * 11 * 13, 1 << 21)));
+
+        for_each_isa([&]() {
+            CHECK_EQ((lhs * rhs).to_vector(), vector<Fraction>(600, Fraction(1, 2)));
+            CHECK_EQ((lhs / lhs).to_vector(), vector<Fraction>(600, Fraction(1, 1)));
+            CHECK_EQ((lhs - lhs).to_vector(), vector<Fraction>(600, Fraction(0, 1)));
+        });
+    }
+
+    TEST_CASE("Reading arrays from streams") {
+        FractionArray fractions;
+        istringstream input(" 1 2 -3 6\n4 -8\t10 5 0 7 ");
+        input >> fractions;
+        CHECK_EQ(fractions.to_vector(), vector<Fraction>{Fraction(1, 2), Fraction(-1, 2), Fraction(-1, 2), Fraction(2, 1), Fraction(0, 1)});
+
+        istringstream empty("  ");
+        empty >> fractions;
+        CHECK(fractions.empty());
+
+        istringstream odd("1 2 3"), zero("1 2 3 0"), garbage("1 2 x 3");
+        CHECK_THROWS_WITH_AS(odd >> fractions, "Invalid input", runtime_error);
+        CHECK_THROWS_WITH_AS(zero >> fractions, "Denominator can't be zero", runtime_error);
+        CHECK_THROWS_WITH_AS(garbage >> fractions, "Invalid input", runtime_error);
+    }
+}
+
+TEST_SUITE("Floating-point filter") {
+    /*
+     * @brief Checks that the filtered comparator and sort agree with operator< on a set of fractions.
+    */
+    template <typename FractionT>
+    static void check_filter(vector<FractionT> fractions) {
+        const FractionLess<CompareMode::Filtered> filtered;
+        const FractionLess<CompareMode::Exact> exact;
+
+        for (size_t i = 0; i < fractions.size(); i++)
+        {
+            const FractionT& other = fractions[(i * 7 + 1) % fractions.size()];
+            CHECK_EQ(filtered(fractions[i], other), fractions[i] < other);
+            CHECK_EQ(filtered(other, fractions[i]), other < fractions[i]);
+            CHECK_EQ(exact(fractions[i], other), fractions[i] < other);
+            CHECK_FALSE(filtered(fractions[i], fractions[i]));
+        }
+
+        vector<FractionT> expected = fractions;
+        std::sort(expected.begin(), expected.end());
+        vector<FractionT> sorted = fractions;
+        ariel::sort(std::span(sorted));
+        CHECK_EQ(sorted, expected);
+
+        sorted = fractions;
+        ariel::sort(std::span(sorted), CompareMode::Exact);
+        CHECK_EQ(sorted, expected);
+
+        sorted = fractions;
+        std::sort(sorted.begin(), sorted.end(), filtered);
+        CHECK_EQ(sorted, expected);
+    }
+
+    TEST_CASE("Random fractions") {
+        std::mt19937_64 rng(23);
+        vector<Fraction> small;
+        vector<Fraction64> large;
+        vector<Fraction128> huge;
+
+        for (int i = 0; i < 2000; i++)
+        {
+            const auto numerator = static_cast<std::int64_t>(rng()), denominator = static_cast<std::int64_t>(rng() >> 1) + 1;
+            small.emplace_back(static_cast<int>(numerator), static_cast<int>(denominator >> 32) + 1);
+            large.emplace_back(numerator, denominator);
+            huge.emplace_back(static_cast<int128_t>(numerator) * denominator + i, static_cast<int128_t>(denominator) * static_cast<std::int64_t>(rng() >> 1) + 1);
+        }
+
+        small.push_back(Fraction(0, 1));
+        large.push_back(Fraction64(0, 1));
+        check_filter(small);
+        check_filter(large);
+        check_filter(huge);
+    }
+
+    TEST_CASE("Near-equal fractions") {
+        // Ratios of consecutive Fibonacci numbers are Farey neighbours, closer than any double can tell apart.
+        vector<Fraction64> neighbours;
+        std::int64_t fib1 = 1, fib2 = 1;
+
+        for (int i = 0; i < 90; i++)
+        {
+            neighbours.emplace_back(fib1, fib2);
+            neighbours.emplace_back(-fib1, fib2);
+            const std::int64_t next = fib1 + fib2;
+            fib1 = fib2;
+            fib2 = next;
+        }
+
+        check_filter(neighbours);
+
+        vector<Fraction> close;
+
+        for (int i = 1; i < 3000; i++)
+        {
+            close.emplace_back(i, i + 1);
+            close.emplace_back(numeric_limits<int>::max() - i, numeric_limits<int>::max() - i + 1);
+        }
+
+        check_filter(close);
+
+        vector<Fraction128> wide;
+        const int128_t base = static_cast<int128_t>(1) << 100;
+
+        for (int i = 1; i < 500; i++)
+            wide.emplace_back(base + i, base + i + 1);
+
+        check_filter(wide);
+    }
+}
+
+TEST_SUITE("Parallel sort") {
+    TEST_CASE("Thread pool") {
+        for (const size_t threads : {size_t{1}, size_t{2}, size_t{5}})
+        {
+            ThreadPool pool(threads);
+            CHECK_EQ(pool.size(), threads);
+
+            vector<int> hits(1000, 0);
+            pool.run(hits.size(), [&](size_t index) { hits[index]++; });
+            CHECK(std::all_of(hits.begin(), hits.end(), [](int count) { return count == 1; }));
+
+            std::atomic<size_t> runs{0};
+            CHECK_THROWS_WITH_AS(pool.run(100, [&](size_t index) {
+                runs++;
+
+                if (index == 42)
+                    throw std::runtime_error("Task failed");
+            }), "Task failed", runtime_error);
+
+            CHECK_GE(runs.load(), 1);
+
+            // After a failure every thread stops claiming tasks, so each one runs at most one failing task.
+            runs = 0;
+            CHECK_THROWS_AS(pool.run(1000, [&](size_t) {
+                runs++;
+                throw std::runtime_error("Task failed");
+            }), runtime_error);
+            CHECK_LE(runs.load(), threads);
+
+            pool.run(0, [](size_t) {});
+            pool.run(3, [&](size_t index) { hits[index] = -1; });
+            CHECK_EQ(hits[2], -1);
+        }
+    }
+
+    TEST_CASE("Matches std::sort") {
+        std::mt19937_64 rng(24);
+        vector<Fraction> small, repeated;
+        vector<Fraction64> large;
+        vector<Fraction128> huge;
+
+        for (int i = 0; i < 50000; i++)
+        {
+            const auto numerator = static_cast<std::int64_t>(rng()), denominator = static_cast<std::int64_t>(rng() >> 1) + 1;
+            small.emplace_back(static_cast<int>(numerator >> (32 + i % 30)), static_cast<int>(denominator >> (32 + i % 20)) + 1);
+            large.emplace_back(numerator >> (i % 60), denominator);
+            huge.emplace_back(static_cast<int128_t>(numerator) * denominator, static_cast<int128_t>(denominator) << (i % 40));
+
+            // Few distinct values and long runs of near-equal ones, which straddle the threads' shares.
+            repeated.emplace_back(static_cast<int>(rng() % 5), 3);
+            repeated.emplace_back(numeric_limits<int>::max() - static_cast<int>(rng() % 1000), numeric_limits<int>::max());
+        }
+
+        for (const size_t threads : {size_t{1}, size_t{3}, size_t{4}})
+        {
+            ThreadPool pool(threads);
+            CAPTURE(threads);
+
+            auto check = [&](auto fractions) {
+                auto expected = fractions;
+                std::sort(expected.begin(), expected.end());
+                parallel_sort(std::span(fractions), pool);
+                CHECK_EQ(fractions, expected);
+            };
+
+            check(small);
+            check(repeated);
+            check(large);
+            check(huge);
+            check(vector<Fraction>(20000, Fraction(1, 3)));
+            check(vector<Fraction>(small.begin(), small.begin() + 100));
+        }
+    }
+}
+
+TEST_SUITE("Pairwise exact summation") {
+    TEST_CASE("Small sums") {
+        CHECK_EQ(ariel::sum(vector<Fraction>{}), BigFraction());
+        CHECK_EQ(ariel::sum(vector<Fraction>{Fraction(3, 4)}), BigFraction(3, 4));
+        CHECK_EQ(ariel::sum(vector<Fraction>{Fraction(1, 2), Fraction(1, 3), Fraction(1, 6)}), BigFraction(1));
+        CHECK_EQ(ariel::sum(vector<Fraction>{Fraction(5, 7), Fraction(0, 1), Fraction(0, 1) - Fraction(5, 7)}), BigFraction());
+        CHECK(ariel::sum(vector<Fraction>{Fraction(1, 2), Fraction(1, 3), Fraction(1, 6)}).is_small());
+
+        // Any input range, also of BigFractions.
+        CHECK_EQ(ariel::sum(list<Fraction64>{Fraction64(1, 3), Fraction64(1, 5), Fraction64(1, 7)}), BigFraction(71, 105));
+        CHECK_EQ(ariel::sum(vector<BigFraction>{BigFraction(BigInt(1), BigInt(1) * BigInt(1LL << 62) * BigInt(1LL << 62)), BigFraction(-1, 4)}),
+            BigFraction(BigInt(1) - BigInt(1LL << 60) * BigInt(1LL << 62), BigInt(1LL << 62) * BigInt(1LL << 62)));
+    }
+
+    TEST_CASE("Promotes instead of overflowing") {
+        // The harmonic numbers outgrow an int after about 20 terms and 128 bits after about 90 terms.
+        for (const int count : {10, 23, 100, 700})
+        {
+            vector<Fraction> terms;
+            BigFraction expected;
+
+            for (int i = 1; i <= count; i++)
+            {
+                terms.emplace_back(1, i);
+                expected = expected + BigFraction(1, i);
+            }
+
+            CAPTURE(count);
+            CHECK_EQ(ariel::sum(terms), expected);
+        }
+
+        const Fraction128 largest(numeric_limits<int128_t>::max(), 1);
+        CHECK_EQ(ariel::sum(vector<Fraction128>{largest, largest, largest}), BigFraction(BigInt(numeric_limits<int128_t>::max()) * BigInt(3), BigInt(1)));
+        CHECK_EQ(ariel::sum(vector<Fraction128>{largest, largest, Fraction128(0, 1) - largest, Fraction128(0, 1) - largest}), BigFraction());
+
+        // The telescoping sum of 1/(k(k+1)) is n/(n+1), the partial sums are demoted back to the inline form.
+        vector<Fraction64> telescoping;
+
+        for (std::int64_t k = 1; k <= 1000; k++)
+            telescoping.emplace_back(1, k * (k + 1));
+
+        const BigFraction total = ariel::sum(telescoping);
+        CHECK_EQ(total, BigFraction(1000, 1001));
+        CHECK(total.is_small());
+    }
+
+    TEST_CASE("Lehmer steps of the BigInt gcd") {
+        std::mt19937_64 rng(25);
+
+        auto random_big = [&](int limbs) {
+            BigInt num(1);
+
+            for (int i = 0; i < limbs; i++)
+                num = num * BigInt(std::uint64_t{1} << 32) + BigInt(static_cast<std::uint32_t>(rng()));
+
+            return num;
+        };
+
+        for (int i = 0; i < 200; i++)
+        {
+            const BigInt factor = random_big(i % 7), num1 = random_big(3 + i % 40) * factor, num2 = random_big(3 + (i * 7) % 40) * factor;
+            BigInt first = num1, second = num2;
+
+            // Plain Euclid.
+            while (!second.is_zero())
+            {
+                BigInt remainder = first % second;
+                first = std::move(second);
+                second = std::move(remainder);
+            }
+
+            CHECK_EQ(BigInt::gcd(num1, num2), first);
+            CHECK_EQ(BigInt::gcd(-num2, num1), first);
+        }
+
+        const BigInt wide = random_big(20);
+        CHECK_EQ(BigInt::gcd(wide, BigInt()), wide);
+        CHECK_EQ(BigInt::gcd(BigInt(), wide), wide);
+        CHECK_EQ(BigInt::gcd(wide, wide * BigInt(6)), wide);
+    }
+
+    TEST_CASE("Parallel reduction matches the sequential one") {
+        std::mt19937_64 rng(25);
+        vector<Fraction> small;
+        vector<Fraction64> large;
+
+        for (int i = 0; i < 20000; i++)
+        {
+            small.emplace_back(static_cast<int>(rng() % 2001) - 1000, static_cast<int>(rng() % 64) + 1);
+            large.emplace_back(static_cast<std::int64_t>(rng() >> 2) - (std::int64_t{1} << 61), static_cast<std::int64_t>(rng() % 1000) + 1);
+        }
+
+        BigFraction expected_small, expected_large;
+
+        for (const Fraction& term : small)
+            expected_small = expected_small + BigFraction(term);
+
+        ThreadPool serial(1);
+        expected_large = ariel::sum(large, serial);
+
+        for (const size_t threads : {size_t{2}, size_t{3}, size_t{4}})
+        {
+            ThreadPool pool(threads);
+            CAPTURE(threads);
+
+            CHECK_EQ(ariel::sum(small, pool), expected_small);
+            CHECK_EQ(ariel::sum(large, pool), expected_large);
+            CHECK_EQ(ariel::sum(std::span(small).first(5000), pool), ariel::sum(list<Fraction>(small.begin(), small.begin() + 5000)));
+        }
+    }
+}
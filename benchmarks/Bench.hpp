@@ -0,0 +1,61 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+
+namespace bench
+{
+    /*
+     * @brief Prevents the compiler from optimizing away a computed value.
+     * @param value The value to keep alive.
+    */
+    template <typename T>
+    inline void keep(const T& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    /*
+     * @brief Runs a function several times and prints the best time per operation.
+     * @param name The name of the measurement.
+     * @param ops The number of operations a single run of the function performs.
+     * @param func The function to measure.
+     * @return double The best time per operation in nanoseconds.
+    */
+    template <typename Func>
+    double run(const char* name, std::size_t ops, Func&& func) {
+        constexpr int repeats = 5;
+        double best = 0;
+
+        for (int i = 0; i < repeats; ++i)
+        {
+            auto start = std::chrono::steady_clock::now();
+            func();
+            auto stop = std::chrono::steady_clock::now();
+            double nanos = std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(ops);
+
+            if (i == 0 || nanos < best)
+                best = nanos;
+        }
+
+        std::printf("  %-48s %10.2f ns/op\n", name, best);
+        return best;
+    }
+}
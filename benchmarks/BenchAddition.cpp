@@ -0,0 +1,78 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Bench.hpp"
+#include "Fraction.hpp"
+
+using namespace ariel;
+
+// The previous addition: full cross product in 64-bit, then a gcd of the full product.
+static std::pair<int, int> cross_product_add(const Fraction& first, const Fraction& second) {
+    long long numerator = static_cast<long long>(first.getNumerator()) * second.getDenominator() + static_cast<long long>(second.getNumerator()) * first.getDenominator();
+    long long denominator = static_cast<long long>(first.getDenominator()) * second.getDenominator();
+    auto magnitude = static_cast<unsigned long long>(std::llabs(numerator));
+    auto gcd_fact = static_cast<long long>(gcd::gcd(magnitude, static_cast<unsigned long long>(denominator)));
+
+    return {static_cast<int>(numerator / gcd_fact), static_cast<int>(denominator / gcd_fact)};
+}
+
+static std::vector<Fraction> make_fractions(std::size_t count, int max_denominator, bool same_denominator) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> numerators(-10000, 10000);
+    std::uniform_int_distribution<int> denominators(1, max_denominator);
+    std::vector<Fraction> fractions;
+    fractions.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+        fractions.emplace_back(numerators(rng), same_denominator ? max_denominator : denominators(rng));
+
+    return fractions;
+}
+
+static void run_suite(const char* title, const std::vector<Fraction>& fractions) {
+    std::printf("%s\n", title);
+
+    bench::run("cross product + full reduce (previous)", fractions.size() - 1, [&] {
+        for (std::size_t i = 1; i < fractions.size(); ++i)
+            bench::keep(cross_product_add(fractions[i - 1], fractions[i]));
+    });
+
+    bench::run("Henrici operator+", fractions.size() - 1, [&] {
+        for (std::size_t i = 1; i < fractions.size(); ++i)
+            bench::keep(fractions[i - 1] + fractions[i]);
+    });
+
+    bench::run("Henrici operator-", fractions.size() - 1, [&] {
+        for (std::size_t i = 1; i < fractions.size(); ++i)
+            bench::keep(fractions[i - 1] - fractions[i]);
+    });
+}
+
+int main() {
+    constexpr std::size_t count = 1 << 20;
+
+    run_suite("random denominators up to 1000", make_fractions(count, 1000, false));
+    run_suite("random denominators up to 30000", make_fractions(count, 30000, false));
+    run_suite("equal denominators (997, prime so they stay equal)", make_fractions(count, 997, true));
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Bench.hpp"
+#include "FractionArray.hpp"
+
+using namespace ariel;
+
+int main() {
+    constexpr std::size_t count = 1 << 20;
+    std::mt19937 rng(21);
+    std::uniform_int_distribution<int> numerators(-10000, 10000), denominators(1, 10000);
+    std::vector<Fraction> lhs, rhs;
+    lhs.reserve(count);
+    rhs.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        lhs.emplace_back(numerators(rng), denominators(rng));
+        rhs.emplace_back(numerators(rng), denominators(rng));
+    }
+
+    std::vector<Fraction> out(count);
+    std::vector<std::int8_t> signs(count);
+    std::vector<int> numerator_parts(count), denominator_parts(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        numerator_parts[i] = lhs[i].getNumerator() * rhs[i].getDenominator();
+        denominator_parts[i] = lhs[i].getDenominator() * rhs[i].getDenominator();
+    }
+
+    std::printf("std::vector<Fraction>\n");
+
+    bench::run("add", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = lhs[i] + rhs[i];
+
+        bench::keep(out.data());
+    });
+
+    bench::run("mul", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = lhs[i] * rhs[i];
+
+        bench::keep(out.data());
+    });
+
+    bench::run("compare", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            signs[i] = static_cast<std::int8_t>((lhs[i] > rhs[i]) - (lhs[i] < rhs[i]));
+
+        bench::keep(signs.data());
+    });
+
+    bench::run("normalize", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = Fraction(numerator_parts[i], denominator_parts[i]);
+
+        bench::keep(out.data());
+    });
+
+    const FractionArray first(lhs), second(rhs);
+    FractionArray result(count);
+
+    for (const auto isa : {FractionArray::Isa::Scalar, FractionArray::Isa::AVX2, FractionArray::Isa::AVX512})
+    {
+        if (!FractionArray::supports(isa))
+            continue;
+
+        FractionArray::set_isa(isa);
+        std::printf("FractionArray (%s)\n", (isa == FractionArray::Isa::Scalar) ? "scalar" : (isa == FractionArray::Isa::AVX2) ? "AVX2" : "AVX-512");
+
+        bench::run("add", count, [&] {
+            FractionArray::add(first, second, result);
+            bench::keep(result.numerators().data());
+        });
+
+        bench::run("mul", count, [&] {
+            FractionArray::mul(first, second, result);
+            bench::keep(result.numerators().data());
+        });
+
+        bench::run("compare", count, [&] {
+            FractionArray::compare(first, second, signs);
+            bench::keep(signs.data());
+        });
+
+        bench::run("normalize", count, [&] {
+            result = FractionArray::from_parts(numerator_parts, denominator_parts);
+            bench::keep(result.numerators().data());
+        });
+    }
+
+    return 0;
+}
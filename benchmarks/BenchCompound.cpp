@@ -0,0 +1,79 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Bench.hpp"
+#include "Fraction.hpp"
+
+using namespace ariel;
+
+/*
+ * @brief Accumulates the terms with the binary operator and a copy assignment, like before.
+*/
+template <typename FractionT, typename Term>
+FractionT accumulate_assign(const std::vector<Term>& terms) {
+    FractionT sum;
+
+    for (const Term& term : terms)
+        sum = sum + term;
+
+    return sum;
+}
+
+/*
+ * @brief Accumulates the terms with the compound operator.
+*/
+template <typename FractionT, typename Term>
+FractionT accumulate_compound(const std::vector<Term>& terms) {
+    FractionT sum;
+
+    for (const Term& term : terms)
+        sum += term;
+
+    return sum;
+}
+
+int main() {
+    constexpr std::size_t count = 1 << 20;
+    std::mt19937 rng(18);
+    std::uniform_int_distribution<int> numerators(-1000, 1000), denominators(1, 12);
+    std::vector<Fraction> fractions;
+    std::vector<Fraction64> fractions64;
+    std::vector<int> integers;
+
+    // Small denominators (powers of 2, or up to 12) keep the long sums in range.
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        fractions.emplace_back(numerators(rng), 1 << (i % 7));
+        fractions64.emplace_back(numerators(rng), denominators(rng));
+        integers.push_back(numerators(rng));
+    }
+
+    std::printf("long accumulation loops (%zu terms)\n", count);
+
+    bench::run("Fraction: sum = sum + x", count, [&] { bench::keep(accumulate_assign<Fraction>(fractions)); });
+    bench::run("Fraction: sum += x", count, [&] { bench::keep(accumulate_compound<Fraction>(fractions)); });
+    bench::run("Fraction: sum = sum + n", count, [&] { bench::keep(accumulate_assign<Fraction>(integers)); });
+    bench::run("Fraction: sum += n", count, [&] { bench::keep(accumulate_compound<Fraction>(integers)); });
+    bench::run("Fraction64: sum = sum + x", count, [&] { bench::keep(accumulate_assign<Fraction64>(fractions64)); });
+    bench::run("Fraction64: sum += x", count, [&] { bench::keep(accumulate_compound<Fraction64>(fractions64)); });
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Bench.hpp"
+#include "Fraction.hpp"
+
+using namespace ariel;
+
+/*
+ * @brief A fraction with the previous user-provided copy and move operations (with the self assignment check),
+ *        which made it non-trivially copyable.
+*/
+class LegacyFraction
+{
+    private:
+        Fraction _fraction;
+
+    public:
+        LegacyFraction() = default;
+        LegacyFraction(const Fraction& fraction): _fraction(fraction) {}
+        LegacyFraction(const LegacyFraction& other): _fraction(other._fraction) {}
+        LegacyFraction(LegacyFraction&& other) noexcept: _fraction(other._fraction) {}
+        ~LegacyFraction() {}
+
+        LegacyFraction& operator=(const LegacyFraction& other) {
+            if (this == &other)
+                return *this;
+
+            _fraction = other._fraction;
+            return *this;
+        }
+
+        LegacyFraction& operator=(LegacyFraction&& other) noexcept {
+            if (this == &other)
+                return *this;
+
+            _fraction = other._fraction;
+            return *this;
+        }
+
+        bool operator<(const LegacyFraction& other) const { return _fraction < other._fraction; }
+};
+
+/*
+ * @brief Measures vector growth, sort and copy of a fraction type.
+*/
+template <typename FractionT>
+void measure(const char* name, const std::vector<Fraction>& fractions) {
+    const std::size_t count = fractions.size();
+    std::vector<FractionT> values(fractions.begin(), fractions.end());
+    std::vector<FractionT> target(count);
+
+    std::printf("%s\n", name);
+
+    bench::run("vector growth (push_back, no reserve)", count, [&] {
+        std::vector<FractionT> grown;
+
+        for (const FractionT& value : values)
+            grown.push_back(value);
+
+        bench::keep(grown.data());
+    });
+
+    bench::run("vector resize (x2)", count, [&] {
+        std::vector<FractionT> resized(values);
+        resized.resize(2 * count);
+        bench::keep(resized.data());
+    });
+
+    bench::run("std::copy", count, [&] {
+        std::copy(values.begin(), values.end(), target.begin());
+        bench::keep(target.data());
+    });
+
+    bench::run("std::sort (a copy)", count, [&] {
+        std::copy(values.begin(), values.end(), target.begin());
+        std::sort(target.begin(), target.end());
+        bench::keep(target.data());
+    });
+}
+
+int main() {
+    constexpr std::size_t count = 1 << 20;
+    std::mt19937 rng(20);
+    std::uniform_int_distribution<int> numerators(-100000, 100000), denominators(1, 100000);
+    std::vector<Fraction> fractions;
+    fractions.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+        fractions.emplace_back(numerators(rng), denominators(rng));
+
+    measure<LegacyFraction>("user-provided copy operations (previous)", fractions);
+    measure<Fraction>("trivially copyable Fraction", fractions);
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Bench.hpp"
+#include "FractionAccumulator.hpp"
+
+using namespace ariel;
+
+int main() {
+    constexpr std::size_t count = 4096;
+    constexpr std::size_t rounds = 256;
+    std::mt19937 rng(17);
+
+    // Portfolio weighting: weights in percents times prices in cents (the sum still fits in an int fraction).
+    std::uniform_int_distribution<int> weights(0, 100), prices(1, 1000);
+    std::vector<Fraction> first, second;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        first.emplace_back(weights(rng), 100);
+        second.emplace_back(prices(rng), 100);
+    }
+
+    std::printf("dot product of %zu weights and prices\n", count);
+
+    bench::run("sum = sum + a * b", count * rounds, [&] {
+        for (std::size_t round = 0; round < rounds; ++round)
+        {
+            Fraction sum;
+
+            for (std::size_t i = 0; i < count; ++i)
+                sum = sum + first[i] * second[i];
+
+            bench::keep(sum);
+        }
+    });
+
+    bench::run("sum = Fraction::fma(a, b, sum)", count * rounds, [&] {
+        for (std::size_t round = 0; round < rounds; ++round)
+        {
+            Fraction sum;
+
+            for (std::size_t i = 0; i < count; ++i)
+                sum = Fraction::fma(first[i], second[i], sum);
+
+            bench::keep(sum);
+        }
+    });
+
+    bench::run("FractionAccumulator::dot", count * rounds, [&] {
+        for (std::size_t round = 0; round < rounds; ++round)
+            bench::keep(FractionAccumulator::dot(first, second));
+    });
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "Bench.hpp"
+#include "FractionSort.hpp"
+
+using namespace ariel;
+
+/*
+ * @brief Measures sorting a dataset with operator<, the filtered comparator and the precomputed-key sort.
+*/
+template <typename FractionT>
+void measure(const char* name, const std::vector<FractionT>& fractions) {
+    std::vector<FractionT> target(fractions.size());
+    std::printf("%s\n", name);
+
+    bench::run("std::sort, operator<", fractions.size(), [&] {
+        std::copy(fractions.begin(), fractions.end(), target.begin());
+        std::sort(target.begin(), target.end());
+        bench::keep(target.data());
+    });
+
+    bench::run("std::sort, FractionLess<Filtered>", fractions.size(), [&] {
+        std::copy(fractions.begin(), fractions.end(), target.begin());
+        std::sort(target.begin(), target.end(), FractionLess<CompareMode::Filtered>{});
+        bench::keep(target.data());
+    });
+
+    bench::run("ariel::sort (precomputed keys)", fractions.size(), [&] {
+        std::copy(fractions.begin(), fractions.end(), target.begin());
+        ariel::sort(std::span(target));
+        bench::keep(target.data());
+    });
+}
+
+int main() {
+    constexpr std::size_t count = 1 << 18;
+    std::mt19937_64 rng(23);
+    std::vector<Fraction> small, close;
+    std::vector<Fraction64> large, near;
+    std::vector<Fraction128> huge;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto numerator = static_cast<std::int64_t>(rng()), denominator = static_cast<std::int64_t>(rng() >> 1) + 1;
+        small.emplace_back(static_cast<int>(numerator >> 32), static_cast<int>(denominator >> 32) + 1);
+        large.emplace_back(numerator, denominator);
+        huge.emplace_back(static_cast<int128_t>(numerator) * denominator, static_cast<int128_t>(denominator) * static_cast<std::int64_t>(rng() >> 1) + 1);
+
+        // Near-equal: all within 2^-20 of 1/3, many closer than a double can tell apart.
+        const auto offset = static_cast<std::int64_t>(rng() % 1024);
+        close.emplace_back(static_cast<int>((1 << 20) + offset), static_cast<int>(3 << 20) + static_cast<int>(rng() % 4));
+        near.emplace_back((std::int64_t{1} << 60) + offset, (std::int64_t{3} << 60) + static_cast<std::int64_t>(rng() % 4));
+    }
+
+    measure("Fraction, random", small);
+    measure("Fraction, near-equal", close);
+    measure("Fraction64, random", large);
+    measure("Fraction64, near-equal", near);
+    measure("Fraction128, random", huge);
+
+    return 0;
+}
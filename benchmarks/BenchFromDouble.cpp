@@ -0,0 +1,64 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Bench.hpp"
+#include "Fraction.hpp"
+
+using namespace ariel;
+
+int main() {
+    constexpr std::size_t count = 1 << 20;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> values(-1000.0F, 1000.0F);
+    std::vector<float> floats(count);
+    std::vector<double> dyadics(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        floats[i] = values(rng);
+        // Multiples of 2^-10 are exactly representable with an int denominator.
+        dyadics[i] = static_cast<double>(static_cast<int>(floats[i] * 1024.0F)) / 1024.0;
+    }
+
+    std::printf("random values in [-1000, 1000]\n");
+
+    bench::run("Fraction(float) (scale by 1000 + gcd)", count, [&] {
+        for (float value : floats)
+            bench::keep(Fraction(value));
+    });
+
+    bench::run("from_double_exact (multiples of 2^-10)", count, [&] {
+        for (double value : dyadics)
+            bench::keep(Fraction::from_double_exact(value));
+    });
+
+    bench::run("from_double_rounded(x, 1000)", count, [&] {
+        for (float value : floats)
+            bench::keep(Fraction::from_double_rounded(value, 1000));
+    });
+
+    bench::run("from_double_rounded(x) (max denominator INT_MAX)", count, [&] {
+        for (float value : floats)
+            bench::keep(Fraction::from_double_rounded(value));
+    });
+
+    return 0;
+}
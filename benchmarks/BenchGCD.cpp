@@ -0,0 +1,114 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Bench.hpp"
+#include "GCD.hpp"
+
+using namespace ariel;
+
+// The original recursive Fraction::_gcd, kept as the baseline.
+static int recursive_gcd(int num1, int num2) {
+    return (num2 == 0) ? num1:recursive_gcd(num2, num1 % num2);
+}
+
+template <typename U>
+static std::vector<std::pair<U, U>> random_pairs(std::size_t count) {
+    std::mt19937_64 rng(42);
+    std::vector<std::pair<U, U>> pairs(count);
+
+    auto draw = [&rng] {
+        auto value = static_cast<U>(rng());
+
+        if constexpr (sizeof(U) > sizeof(std::uint64_t))
+            value = static_cast<U>((value << 64) | rng());
+
+        return static_cast<U>((value >> 1) | 1);
+    };
+
+    for (auto& pair : pairs)
+        pair = {draw(), draw()};
+
+    return pairs;
+}
+
+// Consecutive Fibonacci numbers are the worst case of Euclid's algorithm.
+template <typename U>
+static std::vector<std::pair<U, U>> fibonacci_pairs(std::size_t count) {
+    std::vector<std::pair<U, U>> fibs;
+    U prev = 1, cur = 1;
+
+    while (cur <= (std::numeric_limits<U>::max() >> 1) - prev)
+    {
+        U next = prev + cur;
+        prev = cur;
+        cur = next;
+        fibs.emplace_back(cur, prev);
+    }
+
+    std::vector<std::pair<U, U>> pairs(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+        pairs[i] = fibs[fibs.size() - 1 - (i % 8)];
+
+    return pairs;
+}
+
+template <typename U>
+static void run_suite(const char* title, const std::vector<std::pair<U, U>>& pairs) {
+    std::printf("%s\n", title);
+
+    if constexpr (sizeof(U) == sizeof(int))
+    {
+        bench::run("recursive Euclid (old Fraction::_gcd)", pairs.size(), [&] {
+            for (const auto& [num1, num2] : pairs)
+                bench::keep(recursive_gcd(static_cast<int>(num1), static_cast<int>(num2)));
+        });
+    }
+
+    bench::run("gcd::euclid", pairs.size(), [&] {
+        for (const auto& [num1, num2] : pairs)
+            bench::keep(gcd::euclid(num1, num2));
+    });
+
+    bench::run("gcd::binary", pairs.size(), [&] {
+        for (const auto& [num1, num2] : pairs)
+            bench::keep(gcd::binary(num1, num2));
+    });
+
+    bench::run("gcd::lehmer", pairs.size(), [&] {
+        for (const auto& [num1, num2] : pairs)
+            bench::keep(gcd::lehmer(num1, num2));
+    });
+}
+
+int main() {
+    constexpr std::size_t count = 1 << 20;
+
+    run_suite("32-bit random", random_pairs<std::uint32_t>(count));
+    run_suite("32-bit Fibonacci (worst case)", fibonacci_pairs<std::uint32_t>(count));
+    run_suite("64-bit random", random_pairs<std::uint64_t>(count));
+    run_suite("64-bit Fibonacci (worst case)", fibonacci_pairs<std::uint64_t>(count));
+    run_suite("128-bit random", random_pairs<uint128_t>(count / 4));
+    run_suite("128-bit Fibonacci (worst case)", fibonacci_pairs<uint128_t>(count / 4));
+
+    return 0;
+}
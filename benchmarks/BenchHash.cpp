@@ -0,0 +1,130 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <map>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Bench.hpp"
+#include "FlatHashMap.hpp"
+
+using namespace ariel;
+
+int main() {
+    constexpr std::size_t count = 1 << 20;
+    std::mt19937 rng(16);
+
+    // About a quarter of the keys are repeated, like a deduplication or a group by.
+    std::uniform_int_distribution<int> numerators(-1000, 1000), denominators(1, 1000);
+    std::vector<Fraction> keys;
+    keys.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+        keys.emplace_back(numerators(rng), denominators(rng));
+
+    std::printf("deduplicate %zu keys (set insert)\n", count);
+
+    bench::run("std::set", count, [&] {
+        std::set<Fraction> set;
+
+        for (const Fraction& key : keys)
+            set.insert(key);
+
+        bench::keep(set.size());
+    });
+
+    bench::run("std::unordered_set", count, [&] {
+        std::unordered_set<Fraction> set;
+
+        for (const Fraction& key : keys)
+            set.insert(key);
+
+        bench::keep(set.size());
+    });
+
+    bench::run("FlatHashSet", count, [&] {
+        FlatHashSet<Fraction> set;
+
+        for (const Fraction& key : keys)
+            set.insert(key);
+
+        bench::keep(set.size());
+    });
+
+    std::printf("group by %zu keys (count per key)\n", count);
+
+    bench::run("std::map", count, [&] {
+        std::map<Fraction, int> map;
+
+        for (const Fraction& key : keys)
+            ++map[key];
+
+        bench::keep(map.size());
+    });
+
+    bench::run("std::unordered_map", count, [&] {
+        std::unordered_map<Fraction, int> map;
+
+        for (const Fraction& key : keys)
+            ++map[key];
+
+        bench::keep(map.size());
+    });
+
+    bench::run("FlatHashMap", count, [&] {
+        FlatHashMap<Fraction, int> map;
+
+        for (const Fraction& key : keys)
+            ++map[key];
+
+        bench::keep(map.size());
+    });
+
+    std::printf("lookups (about half of the keys are missing)\n");
+
+    std::map<Fraction, int> tree;
+    std::unordered_map<Fraction, int> hashed;
+    FlatHashMap<Fraction, int> flat;
+
+    for (std::size_t i = 0; i < count; i += 2)
+    {
+        tree[keys[i]] = 1;
+        hashed[keys[i]] = 1;
+        flat[keys[i]] = 1;
+    }
+
+    bench::run("std::map", count, [&] {
+        for (const Fraction& key : keys)
+            bench::keep(tree.find(key) != tree.end());
+    });
+
+    bench::run("std::unordered_map", count, [&] {
+        for (const Fraction& key : keys)
+            bench::keep(hashed.find(key) != hashed.end());
+    });
+
+    bench::run("FlatHashMap", count, [&] {
+        for (const Fraction& key : keys)
+            bench::keep(flat.find(key) != nullptr);
+    });
+
+    return 0;
+}
@@ -0,0 +1,77 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Bench.hpp"
+#include "Fraction.hpp"
+#include "LazyFraction.hpp"
+
+using namespace ariel;
+
+template <typename Frac>
+static std::vector<Frac> make_fractions(std::size_t count, int max_value) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> numerators(-max_value, max_value);
+    std::uniform_int_distribution<int> denominators(1, max_value);
+    std::vector<Frac> fractions;
+    fractions.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+        fractions.push_back(Frac(Fraction(numerators(rng), denominators(rng))));
+
+    return fractions;
+}
+
+// The Demo's "a+b-1", followed by a division and an observation of the result.
+template <typename Frac>
+static void run_chain(const char* name, const std::vector<Frac>& fractions) {
+    bench::run(name, fractions.size() - 2, [&] {
+        for (std::size_t i = 2; i < fractions.size(); ++i)
+        {
+            Frac result = (fractions[i - 2] + fractions[i - 1] - 1) / fractions[i];
+            bench::keep(result.getNumerator());
+        }
+    });
+}
+
+int main() {
+    constexpr std::size_t count = 1 << 20;
+    constexpr int max_value = 100;
+
+    std::printf("(a + b - 1) / c, parts up to %d\n", max_value);
+
+    auto fractions = make_fractions<Fraction>(count, max_value);
+    auto lazy_fractions = make_fractions<LazyFraction>(count, max_value);
+
+    // Zero divisors would throw, shift them away.
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (fractions[i] == Fraction())
+        {
+            fractions[i] = Fraction(1, 1);
+            lazy_fractions[i] = LazyFraction(1, 1);
+        }
+    }
+
+    run_chain("Fraction (reduces after every operator)", fractions);
+    run_chain("LazyFraction (reduces once, when observed)", lazy_fractions);
+
+    return 0;
+}
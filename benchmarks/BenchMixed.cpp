@@ -0,0 +1,110 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Bench.hpp"
+#include "Fraction.hpp"
+
+using namespace ariel;
+
+int main() {
+    constexpr std::size_t count = 1 << 20;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> numerators(-10000, 10000), denominators(1, 10000);
+    std::uniform_real_distribution<float> values(-10.0F, 10.0F);
+    std::vector<Fraction> fractions;
+    std::vector<float> floats(count);
+    fractions.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        fractions.emplace_back(numerators(rng), denominators(rng));
+
+        // Like the StudentTest2 patterns (e.g. 4.321, 3.678), never truncating to 0.
+        floats[i] = values(rng);
+        if (Fraction(floats[i]) == Fraction())
+            floats[i] = 1.5F;
+    }
+
+    // Each pattern: the previous path (a temporary Fraction(float)) and the direct kernel.
+    std::printf("fraction op float, like \"Adding and subtracting floating-point variables from both sides\"\n");
+
+    bench::run("frac + Fraction(x) (previous)", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(fractions[i] + Fraction(floats[i]));
+    });
+
+    bench::run("frac + x", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(fractions[i] + floats[i]);
+    });
+
+    bench::run("Fraction(x) - frac (previous)", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(Fraction(floats[i]) - fractions[i]);
+    });
+
+    bench::run("x - frac", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(floats[i] - fractions[i]);
+    });
+
+    bench::run("frac * Fraction(x) (previous)", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(fractions[i] * Fraction(floats[i]));
+    });
+
+    bench::run("frac * x", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(fractions[i] * floats[i]);
+    });
+
+    bench::run("frac / Fraction(x) (previous)", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(fractions[i] / Fraction(floats[i]));
+    });
+
+    bench::run("frac / x", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(fractions[i] / floats[i]);
+    });
+
+    bench::run("frac < Fraction(x) (previous)", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(fractions[i] < Fraction(floats[i]));
+    });
+
+    bench::run("frac < x", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(fractions[i] < floats[i]);
+    });
+
+    bench::run("Fraction(x) == frac (previous)", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(Fraction(floats[i]) == fractions[i]);
+    });
+
+    bench::run("x == frac", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(floats[i] == fractions[i]);
+    });
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Bench.hpp"
+#include "Fraction.hpp"
+
+using namespace ariel;
+
+template <typename Frac>
+static std::vector<Frac> make_fractions(std::size_t count, typename Frac::int_type max_value) {
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<long long> numerators(-static_cast<long long>(max_value), static_cast<long long>(max_value));
+    std::uniform_int_distribution<long long> denominators(1, static_cast<long long>(max_value));
+    std::vector<Frac> fractions;
+    fractions.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+        fractions.emplace_back(static_cast<typename Frac::int_type>(numerators(rng)), static_cast<typename Frac::int_type>(denominators(rng)));
+
+    return fractions;
+}
+
+template <typename IntT, typename Policy>
+static void run_policy(const char* name, std::size_t count, IntT max_value) {
+    using Frac = BasicFraction<IntT, Policy>;
+    const auto fractions = make_fractions<Frac>(count, max_value);
+    char label[64];
+
+    std::snprintf(label, sizeof(label), "%s operator+", name);
+    bench::run(label, fractions.size() - 1, [&] {
+        for (std::size_t i = 1; i < fractions.size(); ++i)
+            bench::keep(fractions[i - 1] + fractions[i]);
+    });
+
+    std::snprintf(label, sizeof(label), "%s operator*", name);
+    bench::run(label, fractions.size() - 1, [&] {
+        for (std::size_t i = 1; i < fractions.size(); ++i)
+            bench::keep(fractions[i - 1] * fractions[i]);
+    });
+
+    overflow::clear();
+}
+
+template <typename IntT>
+static void run_suite(const char* title, std::size_t count, IntT max_value) {
+    std::printf("%s\n", title);
+    run_policy<IntT, overflow::ThrowOnOverflow>("ThrowOnOverflow", count, max_value);
+    run_policy<IntT, overflow::SaturateOnOverflow>("SaturateOnOverflow", count, max_value);
+    run_policy<IntT, overflow::FlagOnOverflow>("FlagOnOverflow", count, max_value);
+    run_policy<IntT, overflow::UncheckedOverflow>("UncheckedOverflow", count, max_value);
+}
+
+int main() {
+    constexpr std::size_t count = 1 << 20;
+
+    // The parts are small enough that no result overflows, so this is the cost of the checks alone.
+    run_suite<int>("int fractions (parts up to 2^14)", count, 1 << 14);
+    run_suite<int128_t>("int128_t fractions (parts up to 2^60)", count, int128_t{1} << 60);
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "Bench.hpp"
+#include "FractionSort.hpp"
+#include "ThreadPool.hpp"
+
+using namespace ariel;
+
+/*
+ * @brief Measures the sequential sorts and parallel_sort() with 1, 2, 4, ... threads up to the hardware threads,
+ *        and prints the throughput and the speedup over one thread.
+*/
+template <typename FractionT>
+void measure(const char* name, const std::vector<FractionT>& fractions) {
+    const std::size_t count = fractions.size();
+    std::vector<FractionT> target(count);
+    std::printf("%s, %zu fractions\n", name, count);
+
+    bench::run("std::sort, operator<", count, [&] {
+        std::copy(fractions.begin(), fractions.end(), target.begin());
+        std::sort(target.begin(), target.end());
+        bench::keep(target.data());
+    });
+
+    bench::run("ariel::sort (precomputed keys)", count, [&] {
+        std::copy(fractions.begin(), fractions.end(), target.begin());
+        ariel::sort(std::span(target));
+        bench::keep(target.data());
+    });
+
+    const std::size_t hardware = std::max(1U, std::thread::hardware_concurrency());
+    double single = 0;
+
+    for (std::size_t threads = 1; threads <= hardware; threads = (threads == hardware) ? hardware + 1 : std::min(threads * 2, hardware))
+    {
+        ThreadPool pool(threads);
+        char label[64];
+        std::snprintf(label, sizeof(label), "parallel_sort, %zu threads", threads);
+
+        const double nanos = bench::run(label, count, [&] {
+            std::copy(fractions.begin(), fractions.end(), target.begin());
+            parallel_sort(std::span(target), pool);
+            bench::keep(target.data());
+        });
+
+        single = (threads == 1) ? nanos : single;
+        std::printf("  %-48s %10.1f M/s (x%.2f)\n", "", 1e3 / nanos, single / nanos);
+    }
+}
+
+int main() {
+    constexpr std::size_t count = std::size_t{1} << 22;
+    std::mt19937_64 rng(24);
+    std::vector<Fraction> small;
+    std::vector<Fraction64> large;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto numerator = static_cast<std::int64_t>(rng()), denominator = static_cast<std::int64_t>(rng() >> 1) + 1;
+        small.emplace_back(static_cast<int>(numerator >> 32), static_cast<int>(denominator >> 32) + 1);
+        large.emplace_back(numerator, denominator);
+    }
+
+    measure("Fraction", small);
+    measure("Fraction64", large);
+
+    return 0;
+}
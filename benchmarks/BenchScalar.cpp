@@ -0,0 +1,100 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Bench.hpp"
+#include "Fraction.hpp"
+
+using namespace ariel;
+
+int main() {
+    constexpr std::size_t count = 1 << 20;
+    std::mt19937 rng(14);
+    std::uniform_int_distribution<int> numerators(-10000, 10000), denominators(1, 10000), integers(1, 1000);
+    std::uniform_real_distribution<double> values(0.5, 10.0);
+    std::vector<Fraction> fractions;
+    std::vector<int> ints(count);
+    std::vector<double> doubles(count);
+    fractions.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        fractions.emplace_back(numerators(rng), denominators(rng));
+        ints[i] = integers(rng);
+        doubles[i] = values(rng);
+    }
+
+    // Before the scalar overloads, an int operand converted to float and a double operand narrowed to float.
+    std::printf("fraction op int\n");
+
+    bench::run("frac + Fraction(float(n)) (previous)", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(fractions[i] + Fraction(static_cast<float>(ints[i])));
+    });
+
+    bench::run("frac + n", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(fractions[i] + ints[i]);
+    });
+
+    bench::run("frac * Fraction(float(n)) (previous)", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(fractions[i] * Fraction(static_cast<float>(ints[i])));
+    });
+
+    bench::run("frac * n", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(fractions[i] * ints[i]);
+    });
+
+    bench::run("frac < Fraction(float(n)) (previous)", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(fractions[i] < Fraction(static_cast<float>(ints[i])));
+    });
+
+    bench::run("frac < n", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(fractions[i] < ints[i]);
+    });
+
+    std::printf("fraction op double\n");
+
+    bench::run("Fraction(float(x)) * frac (previous)", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(Fraction(static_cast<float>(doubles[i])) * fractions[i]);
+    });
+
+    bench::run("x * frac", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(doubles[i] * fractions[i]);
+    });
+
+    bench::run("frac + Fraction(float(x)) (previous)", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(fractions[i] + Fraction(static_cast<float>(doubles[i])));
+    });
+
+    bench::run("frac + x", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(fractions[i] + doubles[i]);
+    });
+
+    return 0;
+}
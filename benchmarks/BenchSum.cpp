@@ -0,0 +1,103 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "Bench.hpp"
+#include "BigFraction.hpp"
+#include "FractionSum.hpp"
+#include "ThreadPool.hpp"
+
+using namespace ariel;
+
+/*
+ * @brief Measures a left-to-right BigFraction sum (if it's given a length) and sum() with 1, 2, 4, ... threads
+ *        up to the hardware threads, and prints the speedup over one thread.
+*/
+template <typename FractionT>
+void measure(const char* name, const std::vector<FractionT>& terms, std::size_t left_to_right) {
+    std::printf("%s, %zu terms\n", name, terms.size());
+
+    if (left_to_right != 0)
+    {
+        char label[64];
+        std::snprintf(label, sizeof(label), "left to right, first %zu terms", left_to_right);
+
+        bench::run(label, left_to_right, [&] {
+            BigFraction total;
+
+            for (std::size_t i = 0; i < left_to_right; ++i)
+                total = total + BigFraction(terms[i]);
+
+            bench::keep(total);
+        });
+
+        ThreadPool serial(1);
+        const std::vector<FractionT> prefix(terms.begin(), terms.begin() + static_cast<std::ptrdiff_t>(left_to_right));
+        std::snprintf(label, sizeof(label), "sum(), first %zu terms", left_to_right);
+
+        bench::run(label, left_to_right, [&] {
+            bench::keep(ariel::sum(prefix, serial));
+        });
+    }
+
+    const std::size_t hardware = std::max(1U, std::thread::hardware_concurrency());
+    double single = 0;
+
+    for (std::size_t threads = 1; threads <= hardware; threads = (threads == hardware) ? hardware + 1 : std::min(threads * 2, hardware))
+    {
+        ThreadPool pool(threads);
+        char label[64];
+        std::snprintf(label, sizeof(label), "sum(), %zu threads", threads);
+
+        const double nanos = bench::run(label, terms.size(), [&] {
+            bench::keep(ariel::sum(terms, pool));
+        });
+
+        single = (threads == 1) ? nanos : single;
+        std::printf("  %-48s %10s (x%.2f)\n", "", "", single / nanos);
+    }
+}
+
+int main() {
+    // The harmonic series: the exact sum's denominator is about lcm(1..n), 1.44 bits per term.
+    std::vector<Fraction> harmonic, alternating;
+
+    for (int k = 1; k <= 20000; ++k)
+    {
+        harmonic.emplace_back(1, k);
+        alternating.emplace_back((k % 2 != 0) ? 1 : -1, k);
+    }
+
+    // Random terms with small denominators: the denominators grow toward lcm(1..1000), about 1440 bits.
+    std::mt19937_64 rng(25);
+    std::vector<Fraction> bounded;
+
+    for (std::size_t i = 0; i < (std::size_t{1} << 22); ++i)
+        bounded.emplace_back(static_cast<int>(rng() % 2001) - 1000, static_cast<int>(rng() % 1000) + 1);
+
+    measure("Harmonic series 1/k", harmonic, 2000);
+    measure("Alternating harmonic series", alternating, 2000);
+    measure("Denominators up to 1000", bounded, std::size_t{1} << 16);
+
+    return 0;
+}
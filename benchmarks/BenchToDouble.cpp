@@ -0,0 +1,106 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Bench.hpp"
+#include "Fraction.hpp"
+
+using namespace ariel;
+
+/*
+ * @brief The previous way out to floating point: print the fraction and parse the text back.
+*/
+template <typename IntT>
+double through_text(const BasicFraction<IntT>& frac) {
+    std::ostringstream out;
+    out << frac;
+    const std::string text = out.str();
+    const std::size_t slash = text.find('/');
+    return std::stod(text.substr(0, slash)) / std::stod(text.substr(slash + 1));
+}
+
+int main() {
+    constexpr std::size_t count = 1 << 20;
+    std::mt19937_64 rng(15);
+    std::vector<Fraction> fractions;
+    std::vector<Fraction64> narrow64, wide64;
+    std::vector<double> results(count);
+    fractions.reserve(count);
+    narrow64.reserve(count);
+    wide64.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        fractions.emplace_back(static_cast<int>(rng() >> 33) - (1 << 30), static_cast<int>(rng() >> 34) | 1);
+        narrow64.emplace_back(static_cast<std::int64_t>(rng() >> 12) - (std::int64_t{1} << 51), static_cast<std::int64_t>(rng() >> 12) | 1);
+        wide64.emplace_back(static_cast<std::int64_t>(rng() >> 1), static_cast<std::int64_t>(rng() >> 2) | 1);
+    }
+
+    std::printf("Fraction (int)\n");
+
+    bench::run("print and parse (previous)", count / 16, [&] {
+        for (std::size_t i = 0; i < count / 16; ++i)
+            bench::keep(through_text(fractions[i]));
+    });
+
+    bench::run("to_double", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(fractions[i].to_double());
+    });
+
+    bench::run("to_double (bulk)", count, [&] {
+        Fraction::to_double(fractions, results);
+        bench::keep(results.front());
+    });
+
+    std::printf("Fraction64, parts of up to 53 bits (fast path)\n");
+
+    bench::run("to_double", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(narrow64[i].to_double());
+    });
+
+    bench::run("to_double (bulk)", count, [&] {
+        Fraction64::to_double(narrow64, results);
+        bench::keep(results.front());
+    });
+
+    std::printf("Fraction64, 62 and 63-bit parts (exact division)\n");
+
+    bench::run("print and parse (previous, not correctly rounded)", count / 16, [&] {
+        for (std::size_t i = 0; i < count / 16; ++i)
+            bench::keep(through_text(wide64[i]));
+    });
+
+    bench::run("to_double", count, [&] {
+        for (std::size_t i = 0; i < count; ++i)
+            bench::keep(wide64[i].to_double());
+    });
+
+    bench::run("to_double (bulk)", count, [&] {
+        Fraction64::to_double(wide64, results);
+        bench::keep(results.front());
+    });
+
+    return 0;
+}
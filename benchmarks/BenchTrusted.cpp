@@ -0,0 +1,64 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Bench.hpp"
+#include "LazyFraction.hpp"
+
+using namespace ariel;
+
+int main() {
+    constexpr std::size_t count = 1 << 20;
+    std::mt19937 rng(19);
+    std::uniform_int_distribution<int> numerators(-100000, 100000), denominators(1, 100000);
+    std::vector<Fraction> fractions;
+    std::vector<LazyFraction> lazies;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        fractions.emplace_back(numerators(rng), denominators(rng));
+        lazies.emplace_back(numerators(rng), denominators(rng));
+        lazies.back().getNumerator();
+    }
+
+    std::printf("results known to be reduced\n");
+
+    bench::run("Fraction(n + d, d) (previous increment)", count, [&] {
+        for (const Fraction& frac : fractions)
+            bench::keep(Fraction(frac.getNumerator() + frac.getDenominator(), frac.getDenominator()));
+    });
+
+    bench::run("++frac", count, [&] {
+        for (Fraction frac : fractions)
+            bench::keep(++frac);
+    });
+
+    bench::run("Fraction(n, d) from a lazy fraction (previous)", count, [&] {
+        for (const LazyFraction& lazy : lazies)
+            bench::keep(Fraction(lazy.getNumerator(), lazy.getDenominator()));
+    });
+
+    bench::run("LazyFraction::to_fraction", count, [&] {
+        for (const LazyFraction& lazy : lazies)
+            bench::keep(lazy.to_fraction());
+    });
+
+    return 0;
+}
@@ -0,0 +1,178 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include "BigFraction.hpp"
+
+namespace ariel
+{
+    // Construction and storage
+
+    void BigFraction::_release() noexcept {
+        delete reinterpret_cast<_BigRep*>(_bits);
+        _bits = _pack(0, 1);
+    }
+
+    BigFraction::BigFraction(long long numerator, long long denominator) : _bits(_pack(0, 1)) {
+        if (denominator == 0)
+            ARIEL_FRACTION_THROW(std::invalid_argument("Denominator can't be zero"));
+
+        // Negating LLONG_MIN overflows, let the arbitrary precision path handle it.
+        if (numerator == std::numeric_limits<long long>::min() || denominator == std::numeric_limits<long long>::min())
+            *this = _from_big(BigInt(numerator), BigInt(denominator));
+
+        else
+            *this = (denominator < 0) ? _from_wide(-numerator, -denominator) : _from_wide(numerator, denominator);
+    }
+
+    BigFraction::BigFraction(const BigInt& numerator, const BigInt& denominator) : _bits(_pack(0, 1)) {
+        if (denominator.is_zero())
+            ARIEL_FRACTION_THROW(std::invalid_argument("Denominator can't be zero"));
+
+        *this = _from_big(numerator, denominator);
+    }
+
+    BigFraction::BigFraction(const BigFraction& other) : _bits(other._bits) {
+        if (!other.is_small())
+            _bits = reinterpret_cast<std::uint64_t>(new _BigRep(other._rep()));
+    }
+
+    BigFraction& BigFraction::operator=(const BigFraction& other) {
+        if (this != &other)
+        {
+            BigFraction copy(other);
+            *this = std::move(copy);
+        }
+
+        return *this;
+    }
+
+    BigFraction& BigFraction::operator=(BigFraction&& other) noexcept {
+        if (this != &other)
+        {
+            if (!is_small())
+                _release();
+
+            _bits = other._bits;
+            other._bits = _pack(0, 1);
+        }
+
+        return *this;
+    }
+
+    BigFraction BigFraction::_from_wide(long long numerator, long long denominator) {
+        const auto magnitude = (numerator < 0) ? 0ULL - static_cast<unsigned long long>(numerator) : static_cast<unsigned long long>(numerator);
+        const auto divisor = static_cast<long long>(gcd::gcd(magnitude, static_cast<unsigned long long>(denominator)));
+
+        numerator /= divisor;
+        denominator /= divisor;
+
+        if (numerator >= std::numeric_limits<int>::min() && numerator <= std::numeric_limits<int>::max() && denominator <= std::numeric_limits<int>::max())
+            return BigFraction(_pack(static_cast<int>(numerator), static_cast<int>(denominator)), _packed_tag{});
+
+        // Promote.
+        BigFraction result;
+        result._bits = reinterpret_cast<std::uint64_t>(new _BigRep{BigInt(numerator), BigInt(denominator)});
+        return result;
+    }
+
+    BigFraction BigFraction::_from_big(BigInt numerator, BigInt denominator) {
+        if (denominator.is_negative())
+        {
+            numerator = -numerator;
+            denominator = -denominator;
+        }
+
+        BigInt divisor = BigInt::gcd(numerator, denominator);
+
+        if (divisor != BigInt(1))
+        {
+            numerator = numerator / divisor;
+            denominator = denominator / divisor;
+        }
+
+        // Demote.
+        if (numerator.fits<int>() && denominator.fits<int>())
+            return BigFraction(_pack(numerator.to<int>(), denominator.to<int>()), _packed_tag{});
+
+        BigFraction result;
+        result._bits = reinterpret_cast<std::uint64_t>(new _BigRep{std::move(numerator), std::move(denominator)});
+        return result;
+    }
+
+
+    // Slow paths
+
+    BigFraction BigFraction::_add_big(const BigFraction& num1, const BigFraction& num2) {
+        const BigInt den1 = num1.denominator(), den2 = num2.denominator();
+        return _from_big(num1.numerator() * den2 + num2.numerator() * den1, den1 * den2);
+    }
+
+    BigFraction BigFraction::_mul_big(const BigFraction& num1, const BigFraction& num2) {
+        return _from_big(num1.numerator() * num2.numerator(), num1.denominator() * num2.denominator());
+    }
+
+    BigFraction BigFraction::_div_big(const BigFraction& num1, const BigFraction& num2) {
+        if (num2.is_small() && num2._small_numerator() == 0)
+            ARIEL_FRACTION_THROW(std::runtime_error("Can't divide by zero"));
+
+        return _from_big(num1.numerator() * num2.denominator(), num1.denominator() * num2.numerator());
+    }
+
+    std::strong_ordering BigFraction::_compare_big(const BigFraction& num1, const BigFraction& num2) {
+        return num1.numerator() * num2.denominator() <=> num2.numerator() * num1.denominator();
+    }
+
+
+    // Conversions and printing
+
+    BigFraction BigFraction::operator-() const {
+        // -INT_MIN doesn't fit in an int.
+        if (is_small() && _small_numerator() != std::numeric_limits<int>::min())
+            return BigFraction(_pack(-_small_numerator(), _small_denominator()), _packed_tag{});
+
+        return _from_big(-numerator(), denominator());
+    }
+
+    Fraction BigFraction::to_fraction() const {
+        if (!is_small())
+            ARIEL_FRACTION_THROW(std::overflow_error("Fraction overflow"));
+
+        // The inline form is always reduced.
+        return Fraction(_small_numerator(), _small_denominator(), Fraction::_reduced_tag{});
+    }
+
+    double BigFraction::to_double() const {
+        if (is_small())
+            return static_cast<double>(_small_numerator()) / _small_denominator();
+
+        // Divide the top 64 bits of the parts and scale by the difference of their widths, converting the parts
+        // separately overflows to inf/inf beyond about 1024 bits.
+        const BigInt& numerator = _rep().numerator;
+        const BigInt& denominator = _rep().denominator;
+        const double quotient = static_cast<double>(numerator.leading_bits()) / static_cast<double>(denominator.leading_bits());
+        const int exponent = static_cast<int>(std::max<std::size_t>(numerator.bit_width(), 64)) - static_cast<int>(std::max<std::size_t>(denominator.bit_width(), 64));
+
+        return std::ldexp(numerator.is_negative() ? -quotient : quotient, exponent);
+    }
+
+    std::ostream& operator<<(std::ostream& outstream, const BigFraction& frac) {
+        return outstream << frac.numerator() << "/" << frac.denominator();
+    }
+}
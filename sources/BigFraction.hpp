@@ -0,0 +1,299 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include "BigInt.hpp"
+#include "Fraction.hpp"
+
+namespace ariel
+{
+    /*
+     * @brief A rational number that never overflows.
+     * @note Values whose reduced numerator and denominator fit in an int are stored inline, in the same 8 bytes
+     *       as a Fraction, and use 64-bit arithmetic. When a result doesn't fit, it is promoted to a heap
+     *       allocated pair of BigInts, and it's demoted back to the inline form as soon as the reduced value fits again.
+     * @note The inline form has its lowest bit set: the numerator is in the high 32 bits and the denominator
+     *       (at most INT_MAX, so 31 bits) above the tag bit. The heap form is a pointer to a _BigRep, whose
+     *       alignment keeps the lowest bit clear.
+    */
+    class BigFraction
+    {
+        private:
+            /*
+             * @brief The heap representation: a reduced fraction with a positive denominator.
+            */
+            struct _BigRep
+            {
+                BigInt numerator;
+                BigInt denominator;
+            };
+
+            /*
+             * @brief The tag bit of the inline form.
+            */
+            static constexpr std::uint64_t _small_tag = 1;
+
+            /*
+             * @brief Either the inline fraction or a pointer to the heap representation (see above).
+            */
+            std::uint64_t _bits;
+
+            /*
+             * @brief Packs a reduced fraction into the inline form.
+             * @param numerator The numerator.
+             * @param denominator The denominator (positive).
+            */
+            static constexpr std::uint64_t _pack(int numerator, int denominator) noexcept {
+                return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(numerator)) << 32) | (static_cast<std::uint64_t>(denominator) << 1) | _small_tag;
+            }
+
+            /*
+             * @brief Gets the numerator of the inline form.
+            */
+            constexpr int _small_numerator() const noexcept { return static_cast<std::int32_t>(static_cast<std::uint32_t>(_bits >> 32)); }
+
+            /*
+             * @brief Gets the denominator of the inline form.
+            */
+            constexpr int _small_denominator() const noexcept { return static_cast<int>(static_cast<std::uint32_t>(_bits) >> 1); }
+
+            /*
+             * @brief Gets the heap representation.
+            */
+            const _BigRep& _rep() const noexcept { return *reinterpret_cast<const _BigRep*>(_bits); }
+
+            /*
+             * @brief Releases the heap representation, if any.
+            */
+            void _release() noexcept;
+
+            /*
+             * @brief Reduces a fraction with 64-bit parts and stores it inline if it fits, else promotes it.
+             * @param numerator The numerator.
+             * @param denominator The denominator (positive).
+            */
+            static BigFraction _from_wide(long long numerator, long long denominator);
+
+            /*
+             * @brief Reduces an arbitrary precision fraction and stores it inline if it fits (demotion).
+             * @param numerator The numerator.
+             * @param denominator The denominator (not zero).
+            */
+            static BigFraction _from_big(BigInt numerator, BigInt denominator);
+
+            /*
+             * @brief The slow paths of the arithmetic operators (at least one operand is on the heap).
+            */
+            static BigFraction _add_big(const BigFraction& num1, const BigFraction& num2);
+            static BigFraction _mul_big(const BigFraction& num1, const BigFraction& num2);
+            static BigFraction _div_big(const BigFraction& num1, const BigFraction& num2);
+            static std::strong_ordering _compare_big(const BigFraction& num1, const BigFraction& num2);
+
+            /*
+             * @brief Builds an inline fraction from its packed form.
+            */
+            struct _packed_tag {};
+            constexpr BigFraction(std::uint64_t bits, _packed_tag) noexcept : _bits(bits) {}
+
+        public:
+            /*
+             * @brief Default constructor of the BigFraction class.
+             * @note The default fraction is 0/1.
+            */
+            constexpr BigFraction() noexcept : _bits(_pack(0, 1)) {}
+
+            /*
+             * @brief Convert constructor from a Fraction to a BigFraction.
+             * @param fraction The fraction to convert.
+            */
+            constexpr BigFraction(const Fraction& fraction) noexcept : _bits(_pack(fraction.getNumerator(), fraction.getDenominator())) {}
+
+            /*
+             * @brief Constructor of the BigFraction class.
+             * @param numerator The numerator of the fraction.
+             * @param denominator The denominator of the fraction.
+             * @throw invalid_argument if the denominator is 0.
+            */
+            BigFraction(long long numerator, long long denominator = 1);
+
+            /*
+             * @brief Constructor of the BigFraction class from arbitrary precision parts.
+             * @param numerator The numerator of the fraction.
+             * @param denominator The denominator of the fraction.
+             * @throw invalid_argument if the denominator is 0.
+            */
+            BigFraction(const BigInt& numerator, const BigInt& denominator);
+
+            /*
+             * @brief Copy constructor of the BigFraction class.
+             * @param other The fraction to copy.
+            */
+            BigFraction(const BigFraction& other);
+
+            /*
+             * @brief Move constructor of the BigFraction class.
+             * @param other The fraction to move.
+            */
+            BigFraction(BigFraction&& other) noexcept : _bits(other._bits) { other._bits = _pack(0, 1); }
+
+            /*
+             * @brief Destructor of the BigFraction class.
+            */
+            ~BigFraction() { if (!is_small()) _release(); }
+
+            /*
+             * @brief Copy assignment operator of the BigFraction class.
+             * @param other The fraction to copy.
+             * @return BigFraction& A reference to this fraction.
+            */
+            BigFraction& operator=(const BigFraction& other);
+
+            /*
+             * @brief Move assignment operator of the BigFraction class.
+             * @param other The fraction to move.
+             * @return BigFraction& A reference to this fraction.
+            */
+            BigFraction& operator=(BigFraction&& other) noexcept;
+
+            /*
+             * @brief Checks if the fraction is stored inline (it fits in a Fraction).
+             * @return True if the fraction is stored inline, false if it was promoted to the heap.
+            */
+            constexpr bool is_small() const noexcept { return (_bits & _small_tag) != 0; }
+
+            /*
+             * @brief Gets the numerator of the fraction.
+             * @return BigInt The numerator of the fraction.
+            */
+            BigInt numerator() const { return is_small() ? BigInt(_small_numerator()) : _rep().numerator; }
+
+            /*
+             * @brief Gets the denominator of the fraction.
+             * @return BigInt The denominator of the fraction (always positive).
+            */
+            BigInt denominator() const { return is_small() ? BigInt(_small_denominator()) : _rep().denominator; }
+
+            /*
+             * @brief Converts the fraction to a Fraction.
+             * @return Fraction The fraction.
+             * @throw overflow_error if the fraction was promoted (doesn't fit in a Fraction).
+            */
+            Fraction to_fraction() const;
+
+            /*
+             * @brief Converts the fraction to an approximate double.
+             * @return double The approximate value of the fraction.
+            */
+            double to_double() const;
+
+            /*
+             * @brief Adds two fractions.
+             * @throw Never overflows, the result is promoted instead.
+            */
+            friend BigFraction operator+(const BigFraction& num1, const BigFraction& num2) {
+                if (num1.is_small() && num2.is_small())
+                {
+                    const long long den1 = num1._small_denominator(), den2 = num2._small_denominator();
+
+                    // Each product is below 2^62, so the sum fits in a long long.
+                    return _from_wide(static_cast<long long>(num1._small_numerator()) * den2 + static_cast<long long>(num2._small_numerator()) * den1, den1 * den2);
+                }
+
+                return _add_big(num1, num2);
+            }
+
+            /*
+             * @brief Subtracts two fractions.
+            */
+            friend BigFraction operator-(const BigFraction& num1, const BigFraction& num2) {
+                return num1 + (-num2);
+            }
+
+            /*
+             * @brief Multiplies two fractions.
+            */
+            friend BigFraction operator*(const BigFraction& num1, const BigFraction& num2) {
+                if (num1.is_small() && num2.is_small())
+                    return _from_wide(static_cast<long long>(num1._small_numerator()) * num2._small_numerator(), static_cast<long long>(num1._small_denominator()) * num2._small_denominator());
+
+                return _mul_big(num1, num2);
+            }
+
+            /*
+             * @brief Divides two fractions.
+             * @throw runtime_error if the divisor is 0.
+            */
+            friend BigFraction operator/(const BigFraction& num1, const BigFraction& num2) {
+                if (num1.is_small() && num2.is_small())
+                {
+                    long long numerator = static_cast<long long>(num1._small_numerator()) * num2._small_denominator();
+                    long long denominator = static_cast<long long>(num1._small_denominator()) * num2._small_numerator();
+
+                    if (denominator == 0)
+                        ARIEL_FRACTION_THROW(std::runtime_error("Can't divide by zero"));
+
+                    return (denominator < 0) ? _from_wide(-numerator, -denominator) : _from_wide(numerator, denominator);
+                }
+
+                return _div_big(num1, num2);
+            }
+
+            /*
+             * @brief Negates the fraction.
+             * @return BigFraction The negated fraction.
+            */
+            BigFraction operator-() const;
+
+            /*
+             * @brief Compares two fractions.
+             * @note Both forms are always reduced and a value has exactly one form, so the inline forms compare bitwise.
+            */
+            friend bool operator==(const BigFraction& num1, const BigFraction& num2) {
+                if (num1.is_small() || num2.is_small())
+                    return num1._bits == num2._bits;
+
+                return num1._rep().numerator == num2._rep().numerator && num1._rep().denominator == num2._rep().denominator;
+            }
+
+            /*
+             * @brief Three-way compares two fractions.
+            */
+            friend std::strong_ordering operator<=>(const BigFraction& num1, const BigFraction& num2) {
+                if (num1.is_small() && num2.is_small())
+                {
+                    return static_cast<long long>(num1._small_numerator()) * num2._small_denominator()
+                        <=> static_cast<long long>(num2._small_numerator()) * num1._small_denominator();
+                }
+
+                return _compare_big(num1, num2);
+            }
+
+            /*
+             * @brief Prints the fraction to the output stream as "numerator/denominator".
+            */
+            friend std::ostream& operator<<(std::ostream& outstream, const BigFraction& frac);
+    };
+
+    static_assert(sizeof(BigFraction) == sizeof(Fraction), "BigFraction must stay as small as a Fraction");
+    static_assert(alignof(BigInt) > 1, "The heap form relies on the lowest pointer bit being clear");
+}
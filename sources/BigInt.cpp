@@ -0,0 +1,445 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include "BigInt.hpp"
+#include "OverflowPolicy.hpp"
+
+namespace ariel
+{
+    // Magnitude helpers
+
+    void BigInt::_trim() {
+        while (!_limbs.empty() && _limbs.back() == 0)
+            _limbs.pop_back();
+
+        if (_limbs.empty())
+            _negative = false;
+    }
+
+    BigInt BigInt::_from_magnitude(std::vector<Limb> limbs, bool negative) {
+        BigInt result;
+        result._limbs = std::move(limbs);
+        result._negative = negative;
+        result._trim();
+        return result;
+    }
+
+    std::strong_ordering BigInt::_compare_magnitudes(const std::vector<Limb>& first, const std::vector<Limb>& second) {
+        if (first.size() != second.size())
+            return first.size() <=> second.size();
+
+        for (std::size_t i = first.size(); i-- > 0;)
+        {
+            if (first[i] != second[i])
+                return first[i] <=> second[i];
+        }
+
+        return std::strong_ordering::equal;
+    }
+
+    std::vector<BigInt::Limb> BigInt::_add_magnitudes(const std::vector<Limb>& first, const std::vector<Limb>& second) {
+        const auto& longer = (first.size() >= second.size()) ? first : second;
+        const auto& shorter = (first.size() >= second.size()) ? second : first;
+        std::vector<Limb> result(longer.size() + 1);
+        std::uint64_t carry = 0;
+
+        for (std::size_t i = 0; i < longer.size(); ++i)
+        {
+            carry += static_cast<std::uint64_t>(longer[i]) + (i < shorter.size() ? shorter[i] : 0U);
+            result[i] = static_cast<Limb>(carry);
+            carry >>= limb_bits;
+        }
+
+        result[longer.size()] = static_cast<Limb>(carry);
+        return result;
+    }
+
+    std::vector<BigInt::Limb> BigInt::_sub_magnitudes(const std::vector<Limb>& first, const std::vector<Limb>& second) {
+        std::vector<Limb> result(first.size());
+        std::uint64_t borrow = 0;
+
+        for (std::size_t i = 0; i < first.size(); ++i)
+        {
+            std::uint64_t subtrahend = borrow + (i < second.size() ? second[i] : 0U);
+            std::uint64_t minuend = first[i];
+            borrow = (minuend < subtrahend) ? 1 : 0;
+            result[i] = static_cast<Limb>(minuend + (borrow << limb_bits) - subtrahend);
+        }
+
+        return result;
+    }
+
+    std::vector<BigInt::Limb> BigInt::_mul_magnitudes(const std::vector<Limb>& first, const std::vector<Limb>& second) {
+        if (first.empty() || second.empty())
+            return {};
+
+        std::vector<Limb> result(first.size() + second.size());
+
+        for (std::size_t i = 0; i < first.size(); ++i)
+        {
+            std::uint64_t carry = 0;
+
+            for (std::size_t j = 0; j < second.size(); ++j)
+            {
+                carry += static_cast<std::uint64_t>(first[i]) * second[j] + result[i + j];
+                result[i + j] = static_cast<Limb>(carry);
+                carry >>= limb_bits;
+            }
+
+            result[i + second.size()] = static_cast<Limb>(carry);
+        }
+
+        return result;
+    }
+
+    std::uint64_t BigInt::_extract_bits(const std::vector<Limb>& limbs, std::size_t shift) {
+        const std::size_t index = shift / limb_bits;
+        uint128_t window = 0;
+
+        for (std::size_t i = std::min(index + 3, limbs.size()); i-- > index;)
+            window = (window << limb_bits) | limbs[i];
+
+        return static_cast<std::uint64_t>(window >> (shift % limb_bits));
+    }
+
+    std::vector<BigInt::Limb> BigInt::_combine_magnitudes(const std::vector<Limb>& first, std::int64_t coef1, const std::vector<Limb>& second, std::int64_t coef2) {
+        std::vector<Limb> result(first.size());
+        int128_t carry = 0;
+
+        for (std::size_t i = 0; i < first.size(); ++i)
+        {
+            carry += static_cast<int128_t>(coef1) * first[i];
+
+            if (i < second.size())
+                carry += static_cast<int128_t>(coef2) * second[i];
+
+            result[i] = static_cast<Limb>(carry);
+            carry >>= limb_bits;
+        }
+
+        return result;
+    }
+
+    void BigInt::_divmod_magnitudes(const std::vector<Limb>& dividend, const std::vector<Limb>& divisor, std::vector<Limb>& quotient, std::vector<Limb>& remainder) {
+        constexpr std::uint64_t base = std::uint64_t{1} << limb_bits;
+        const std::size_t len_v = divisor.size();
+
+        if (_compare_magnitudes(dividend, divisor) < 0)
+        {
+            quotient.clear();
+            remainder = dividend;
+            return;
+        }
+
+        const std::size_t len_u = dividend.size();
+        quotient.assign(len_u - len_v + 1, 0);
+
+        // Single limb divisor: short division.
+        if (len_v == 1)
+        {
+            std::uint64_t rem = 0;
+
+            for (std::size_t i = len_u; i-- > 0;)
+            {
+                std::uint64_t cur = (rem << limb_bits) | dividend[i];
+                quotient[i] = static_cast<Limb>(cur / divisor[0]);
+                rem = cur % divisor[0];
+            }
+
+            remainder.assign(1, static_cast<Limb>(rem));
+            return;
+        }
+
+        // Normalize so that the top limb of the divisor has its high bit set.
+        const int shift = std::countl_zero(divisor.back());
+        std::vector<Limb> norm_v(len_v), norm_u(len_u + 1);
+
+        for (std::size_t i = len_v; i-- > 0;)
+        {
+            std::uint64_t low = (i > 0 && shift != 0) ? (divisor[i - 1] >> (limb_bits - shift)) : 0;
+            norm_v[i] = static_cast<Limb>((static_cast<std::uint64_t>(divisor[i]) << shift) | low);
+        }
+
+        norm_u[len_u] = (shift != 0) ? static_cast<Limb>(dividend[len_u - 1] >> (limb_bits - shift)) : 0;
+
+        for (std::size_t i = len_u; i-- > 0;)
+        {
+            std::uint64_t low = (i > 0 && shift != 0) ? (dividend[i - 1] >> (limb_bits - shift)) : 0;
+            norm_u[i] = static_cast<Limb>((static_cast<std::uint64_t>(dividend[i]) << shift) | low);
+        }
+
+        for (std::size_t j = len_u - len_v + 1; j-- > 0;)
+        {
+            // Estimate the quotient limb from the top two limbs and correct it (at most twice).
+            std::uint64_t top = (static_cast<std::uint64_t>(norm_u[j + len_v]) << limb_bits) | norm_u[j + len_v - 1];
+            std::uint64_t qhat = top / norm_v[len_v - 1];
+            std::uint64_t rhat = top % norm_v[len_v - 1];
+
+            while (qhat >= base || qhat * norm_v[len_v - 2] > ((rhat << limb_bits) | norm_u[j + len_v - 2]))
+            {
+                --qhat;
+                rhat += norm_v[len_v - 1];
+
+                if (rhat >= base)
+                    break;
+            }
+
+            // Multiply and subtract.
+            std::int64_t borrow = 0;
+            std::int64_t diff = 0;
+
+            for (std::size_t i = 0; i < len_v; ++i)
+            {
+                std::uint64_t product = qhat * norm_v[i];
+                diff = static_cast<std::int64_t>(norm_u[i + j]) - borrow - static_cast<std::int64_t>(product & (base - 1));
+                norm_u[i + j] = static_cast<Limb>(diff);
+                borrow = static_cast<std::int64_t>(product >> limb_bits) - (diff >> limb_bits);
+            }
+
+            diff = static_cast<std::int64_t>(norm_u[j + len_v]) - borrow;
+            norm_u[j + len_v] = static_cast<Limb>(diff);
+
+            // The estimate was one too large: add the divisor back.
+            if (diff < 0)
+            {
+                --qhat;
+                std::uint64_t carry = 0;
+
+                for (std::size_t i = 0; i < len_v; ++i)
+                {
+                    carry += static_cast<std::uint64_t>(norm_u[i + j]) + norm_v[i];
+                    norm_u[i + j] = static_cast<Limb>(carry);
+                    carry >>= limb_bits;
+                }
+
+                norm_u[j + len_v] = static_cast<Limb>(norm_u[j + len_v] + carry);
+            }
+
+            quotient[j] = static_cast<Limb>(qhat);
+        }
+
+        // Unnormalize the remainder.
+        remainder.assign(len_v, 0);
+
+        for (std::size_t i = 0; i < len_v; ++i)
+        {
+            std::uint64_t high = (shift != 0) ? (static_cast<std::uint64_t>(norm_u[i + 1]) << (limb_bits - shift)) : 0;
+            remainder[i] = static_cast<Limb>((norm_u[i] >> shift) | high);
+        }
+    }
+
+
+    // Queries and conversions
+
+    std::size_t BigInt::bit_width() const {
+        if (_limbs.empty())
+            return 0;
+
+        return (_limbs.size() - 1) * limb_bits + static_cast<std::size_t>(std::bit_width(_limbs.back()));
+    }
+
+    std::uint64_t BigInt::leading_bits() const {
+        const std::size_t width = bit_width();
+        return _extract_bits(_limbs, (width > 64) ? width - 64 : 0);
+    }
+
+    double BigInt::to_double() const {
+        // The top 64 bits; the remaining bits only matter for the last rounding step.
+        const std::size_t width = bit_width();
+        const double value = std::ldexp(static_cast<double>(leading_bits()), static_cast<int>((width > 64) ? width - 64 : 0));
+        return _negative ? -value : value;
+    }
+
+    std::string BigInt::to_string() const {
+        if (_limbs.empty())
+            return "0";
+
+        // Peel off 9 decimal digits at a time.
+        constexpr Limb chunk = 1000000000;
+        constexpr int chunk_digits = 9;
+        std::vector<Limb> magnitude = _limbs;
+        std::string digits;
+
+        while (!magnitude.empty())
+        {
+            std::uint64_t rem = 0;
+
+            for (std::size_t i = magnitude.size(); i-- > 0;)
+            {
+                std::uint64_t cur = (rem << limb_bits) | magnitude[i];
+                magnitude[i] = static_cast<Limb>(cur / chunk);
+                rem = cur % chunk;
+            }
+
+            while (!magnitude.empty() && magnitude.back() == 0)
+                magnitude.pop_back();
+
+            for (int i = 0; i < chunk_digits && (rem != 0 || !magnitude.empty()); ++i)
+            {
+                digits.push_back(static_cast<char>('0' + rem % 10));
+                rem /= 10;
+            }
+        }
+
+        if (_negative)
+            digits.push_back('-');
+
+        std::reverse(digits.begin(), digits.end());
+        return digits;
+    }
+
+
+    // Arithmetic
+
+    BigInt BigInt::abs() const {
+        return _from_magnitude(_limbs, false);
+    }
+
+    BigInt BigInt::operator-() const {
+        return _from_magnitude(_limbs, !_negative);
+    }
+
+    BigInt operator+(const BigInt& num1, const BigInt& num2) {
+        if (num1._negative == num2._negative)
+            return BigInt::_from_magnitude(BigInt::_add_magnitudes(num1._limbs, num2._limbs), num1._negative);
+
+        if (BigInt::_compare_magnitudes(num1._limbs, num2._limbs) >= 0)
+            return BigInt::_from_magnitude(BigInt::_sub_magnitudes(num1._limbs, num2._limbs), num1._negative);
+
+        return BigInt::_from_magnitude(BigInt::_sub_magnitudes(num2._limbs, num1._limbs), num2._negative);
+    }
+
+    BigInt operator-(const BigInt& num1, const BigInt& num2) {
+        return num1 + (-num2);
+    }
+
+    BigInt operator*(const BigInt& num1, const BigInt& num2) {
+        return BigInt::_from_magnitude(BigInt::_mul_magnitudes(num1._limbs, num2._limbs), num1._negative != num2._negative);
+    }
+
+    void BigInt::divmod(const BigInt& dividend, const BigInt& divisor, BigInt& quotient, BigInt& remainder) {
+        if (divisor.is_zero())
+            ARIEL_FRACTION_THROW(std::runtime_error("Can't divide by zero"));
+
+        std::vector<Limb> quot, rem;
+        _divmod_magnitudes(dividend._limbs, divisor._limbs, quot, rem);
+
+        quotient = _from_magnitude(std::move(quot), dividend._negative != divisor._negative);
+        remainder = _from_magnitude(std::move(rem), dividend._negative);
+    }
+
+    BigInt operator/(const BigInt& num1, const BigInt& num2) {
+        BigInt quotient, remainder;
+        BigInt::divmod(num1, num2, quotient, remainder);
+        return quotient;
+    }
+
+    BigInt operator%(const BigInt& num1, const BigInt& num2) {
+        BigInt quotient, remainder;
+        BigInt::divmod(num1, num2, quotient, remainder);
+        return remainder;
+    }
+
+    BigInt BigInt::gcd(BigInt num1, BigInt num2) {
+        num1._negative = false;
+        num2._negative = false;
+
+        if (num1 < num2)
+            std::swap(num1, num2);
+
+        // Lehmer's algorithm while both are wider than 64 bits, like gcd::lehmer() with 62-bit leading digits:
+        // the Euclid steps simulated on the digits are applied at once with a 2x2 cofactor matrix.
+        constexpr int lead_bits = std::numeric_limits<std::int64_t>::digits - 1;
+
+        while (num2._limbs.size() > 2)
+        {
+            const std::size_t shift = num1.bit_width() - lead_bits;
+            auto lead1 = static_cast<std::int64_t>(_extract_bits(num1._limbs, shift));
+            auto lead2 = static_cast<std::int64_t>(_extract_bits(num2._limbs, shift));
+            std::int64_t coef_a = 1, coef_b = 0, coef_c = 0, coef_d = 1;
+
+            while (lead2 + coef_c != 0 && lead2 + coef_d != 0)
+            {
+                const std::int64_t quot = (lead1 + coef_a) / (lead2 + coef_c);
+
+                if (quot != (lead1 + coef_b) / (lead2 + coef_d))
+                    break;
+
+                std::int64_t temp = coef_a - quot * coef_c;
+                coef_a = coef_c;
+                coef_c = temp;
+
+                temp = coef_b - quot * coef_d;
+                coef_b = coef_d;
+                coef_d = temp;
+
+                temp = lead1 - quot * lead2;
+                lead1 = lead2;
+                lead2 = temp;
+            }
+
+            if (coef_b == 0)
+            {
+                BigInt quotient, remainder;
+                divmod(num1, num2, quotient, remainder);
+                num1 = std::move(num2);
+                num2 = std::move(remainder);
+            }
+
+            else
+            {
+                BigInt next1 = _from_magnitude(_combine_magnitudes(num1._limbs, coef_a, num2._limbs, coef_b), false);
+                num2 = _from_magnitude(_combine_magnitudes(num1._limbs, coef_c, num2._limbs, coef_d), false);
+                num1 = std::move(next1);
+            }
+        }
+
+        // Euclid's algorithm until both fit in 64 bits, then the selected fixed width engine.
+        while (num2._limbs.size() > 2 || num1._limbs.size() > 2)
+        {
+            if (num2.is_zero())
+                return num1;
+
+            BigInt quotient, remainder;
+            divmod(num1, num2, quotient, remainder);
+            num1 = std::move(num2);
+            num2 = std::move(remainder);
+        }
+
+        return BigInt(gcd::gcd(num1.to<std::uint64_t>(), num2.to<std::uint64_t>()));
+    }
+
+
+    // Comparison and printing
+
+    std::strong_ordering operator<=>(const BigInt& num1, const BigInt& num2) {
+        if (num1._negative != num2._negative)
+            return num1._negative ? std::strong_ordering::less : std::strong_ordering::greater;
+
+        auto ordering = BigInt::_compare_magnitudes(num1._limbs, num2._limbs);
+        return num1._negative ? (0 <=> ordering) : ordering;
+    }
+
+    std::ostream& operator<<(std::ostream& outstream, const BigInt& num) {
+        return outstream << num.to_string();
+    }
+}
@@ -0,0 +1,287 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "GCD.hpp"
+
+namespace ariel
+{
+    namespace detail
+    {
+        /*
+         * @brief An unsigned type wide enough for the magnitude of any value of IntT (also for int128_t).
+        */
+        template <typename IntT>
+        using big_int_unsigned_t = std::conditional_t<(std::numeric_limits<IntT>::digits > std::numeric_limits<std::uint64_t>::digits), uint128_t, std::uint64_t>;
+    }
+
+    /*
+     * @brief An arbitrary precision signed integer.
+     * @note The magnitude is stored as little-endian 32-bit limbs without leading zero limbs (zero has no limbs).
+     * @note Only what BigFraction needs is implemented: arithmetic, comparison, gcd and conversions.
+    */
+    class BigInt
+    {
+        private:
+            /*
+             * @brief A 32-bit limb of the magnitude.
+            */
+            using Limb = std::uint32_t;
+
+            /*
+             * @brief The magnitude, little-endian, without leading zero limbs.
+            */
+            std::vector<Limb> _limbs;
+
+            /*
+             * @brief True if the number is negative (never true for zero).
+            */
+            bool _negative = false;
+
+            /*
+             * @brief The number of bits in a limb.
+            */
+            static constexpr int limb_bits = std::numeric_limits<Limb>::digits;
+
+            /*
+             * @brief Removes leading zero limbs (and the sign of zero).
+            */
+            void _trim();
+
+            /*
+             * @brief Compares the magnitudes of two numbers.
+             * @return std::strong_ordering The ordering of |first| relative to |second|.
+            */
+            static std::strong_ordering _compare_magnitudes(const std::vector<Limb>& first, const std::vector<Limb>& second);
+
+            /*
+             * @brief Adds two magnitudes.
+            */
+            static std::vector<Limb> _add_magnitudes(const std::vector<Limb>& first, const std::vector<Limb>& second);
+
+            /*
+             * @brief Subtracts two magnitudes.
+             * @note The first magnitude must not be smaller than the second one.
+            */
+            static std::vector<Limb> _sub_magnitudes(const std::vector<Limb>& first, const std::vector<Limb>& second);
+
+            /*
+             * @brief Multiplies two magnitudes (schoolbook multiplication).
+            */
+            static std::vector<Limb> _mul_magnitudes(const std::vector<Limb>& first, const std::vector<Limb>& second);
+
+            /*
+             * @brief Divides two magnitudes (Knuth's algorithm D).
+             * @param dividend The dividend.
+             * @param divisor The divisor (must not be zero).
+             * @param quotient The quotient (output).
+             * @param remainder The remainder (output).
+            */
+            static void _divmod_magnitudes(const std::vector<Limb>& dividend, const std::vector<Limb>& divisor, std::vector<Limb>& quotient, std::vector<Limb>& remainder);
+
+            /*
+             * @brief Gets up to 64 bits of a magnitude.
+             * @param limbs The magnitude.
+             * @param shift The index of the lowest bit.
+             * @return std::uint64_t The bits from shift up (the higher ones are truncated).
+            */
+            static std::uint64_t _extract_bits(const std::vector<Limb>& limbs, std::size_t shift);
+
+            /*
+             * @brief Calculates a linear combination of two magnitudes (a step of Lehmer's algorithm).
+             * @param first The first magnitude (the longer one).
+             * @param coef1 The coefficient of the first magnitude.
+             * @param second The second magnitude.
+             * @param coef2 The coefficient of the second magnitude.
+             * @return std::vector<Limb> The magnitude of coef1 * first + coef2 * second (it must be non-negative and no longer than first).
+             * @note The coefficients are less than 2^62 in magnitude, so a limb's products and the carry fit in 128 bits.
+            */
+            static std::vector<Limb> _combine_magnitudes(const std::vector<Limb>& first, std::int64_t coef1, const std::vector<Limb>& second, std::int64_t coef2);
+
+            /*
+             * @brief Builds a number from a sign and a magnitude.
+            */
+            static BigInt _from_magnitude(std::vector<Limb> limbs, bool negative);
+
+        public:
+            /*
+             * @brief Default constructor of the BigInt class.
+             * @note The default number is zero.
+            */
+            BigInt() = default;
+
+            /*
+             * @brief Convert constructor from any integer type (including int128_t) to BigInt.
+             * @param value The value to convert.
+            */
+            template <typename IntT, typename = std::enable_if_t<std::numeric_limits<IntT>::is_integer>>
+            BigInt(IntT value) {
+                using U = detail::big_int_unsigned_t<IntT>;
+
+                _negative = value < 0;
+                auto magnitude = _negative ? static_cast<U>(U{0} - static_cast<U>(value)) : static_cast<U>(value);
+
+                while (magnitude != 0)
+                {
+                    _limbs.push_back(static_cast<Limb>(magnitude));
+                    magnitude >>= limb_bits;
+                }
+            }
+
+            /*
+             * @brief Checks if the number is zero.
+             * @return True if the number is zero, false otherwise.
+            */
+            bool is_zero() const { return _limbs.empty(); }
+
+            /*
+             * @brief Checks if the number is negative.
+             * @return True if the number is negative, false otherwise.
+            */
+            bool is_negative() const { return _negative; }
+
+            /*
+             * @brief Gets the number of significant bits of the magnitude.
+             * @return std::size_t The number of significant bits (0 for zero).
+            */
+            std::size_t bit_width() const;
+
+            /*
+             * @brief Checks if the number fits in an integer type.
+             * @return True if the number is representable in IntT, false otherwise.
+            */
+            template <typename IntT>
+            bool fits() const {
+                return *this >= BigInt(std::numeric_limits<IntT>::min()) && *this <= BigInt(std::numeric_limits<IntT>::max());
+            }
+
+            /*
+             * @brief Converts the number to an integer type.
+             * @return IntT The number (wrapped modulo 2^bits if it doesn't fit, check fits<IntT>() first).
+            */
+            template <typename IntT>
+            IntT to() const {
+                using U = detail::big_int_unsigned_t<IntT>;
+                U magnitude = 0;
+
+                for (std::size_t i = _limbs.size(); i-- > 0;)
+                    magnitude = static_cast<U>(magnitude << limb_bits) | _limbs[i];
+
+                return static_cast<IntT>(_negative ? static_cast<U>(U{0} - magnitude) : magnitude);
+            }
+
+            /*
+             * @brief Gets the 64 most significant bits of the magnitude.
+             * @return std::uint64_t The magnitude shifted right by bit_width() - 64 bits (if it's wider than 64 bits).
+             * @note With bit_width() this represents the number as a floating point value, also when it's beyond the range of double.
+            */
+            std::uint64_t leading_bits() const;
+
+            /*
+             * @brief Converts the number to the nearest double (truncated to the top 64 significant bits).
+             * @return double The approximate value.
+            */
+            double to_double() const;
+
+            /*
+             * @brief Converts the number to its decimal representation.
+             * @return std::string The decimal representation.
+            */
+            std::string to_string() const;
+
+            /*
+             * @brief Calculates the greatest common divisor of two numbers (always non-negative).
+             * @param num1 The first number.
+             * @param num2 The second number.
+             * @return BigInt The greatest common divisor of the two numbers.
+            */
+            static BigInt gcd(BigInt num1, BigInt num2);
+
+            /*
+             * @brief Calculates the quotient (truncated toward zero) and the remainder of a division.
+             * @param dividend The dividend.
+             * @param divisor The divisor.
+             * @param quotient The quotient (output).
+             * @param remainder The remainder (output), it has the sign of the dividend.
+             * @throw runtime_error if the divisor is zero.
+            */
+            static void divmod(const BigInt& dividend, const BigInt& divisor, BigInt& quotient, BigInt& remainder);
+
+            /*
+             * @brief Gets the absolute value of the number.
+             * @return BigInt The absolute value.
+            */
+            BigInt abs() const;
+
+            /*
+             * @brief Negates the number.
+             * @return BigInt The negated number.
+            */
+            BigInt operator-() const;
+
+            /*
+             * @brief Adds two numbers.
+            */
+            friend BigInt operator+(const BigInt& num1, const BigInt& num2);
+
+            /*
+             * @brief Subtracts two numbers.
+            */
+            friend BigInt operator-(const BigInt& num1, const BigInt& num2);
+
+            /*
+             * @brief Multiplies two numbers.
+            */
+            friend BigInt operator*(const BigInt& num1, const BigInt& num2);
+
+            /*
+             * @brief Divides two numbers (truncated toward zero).
+             * @throw runtime_error if the divisor is zero.
+            */
+            friend BigInt operator/(const BigInt& num1, const BigInt& num2);
+
+            /*
+             * @brief Calculates the remainder of a division (with the sign of the dividend).
+             * @throw runtime_error if the divisor is zero.
+            */
+            friend BigInt operator%(const BigInt& num1, const BigInt& num2);
+
+            /*
+             * @brief Compares two numbers.
+            */
+            friend bool operator==(const BigInt& num1, const BigInt& num2) = default;
+
+            /*
+             * @brief Three-way compares two numbers.
+            */
+            friend std::strong_ordering operator<=>(const BigInt& num1, const BigInt& num2);
+
+            /*
+             * @brief Prints the number to the output stream in decimal.
+            */
+            friend std::ostream& operator<<(std::ostream& outstream, const BigInt& num);
+    };
+}
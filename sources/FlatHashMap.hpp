@@ -0,0 +1,395 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "Fraction.hpp"
+
+namespace ariel
+{
+    namespace detail
+    {
+        /*
+         * @brief An open addressing hash table of fraction keys with linear probing.
+         * @note The slots are stored inline in a single array, with no separate metadata: an empty slot holds
+         *       a key with a 0 denominator, which no valid fraction has. For an int Fraction key a set slot is
+         *       8 bytes, so a cache line holds 8 of them and most lookups touch a single line.
+         * @note Erasing shifts the following entries of the probe sequence back (no tombstones), so lookups
+         *       never slow down after many erasures.
+         * @note Key must be a BasicFraction, Slot an aggregate whose first member is "Key key".
+        */
+        template <typename Key, typename Slot, typename Hash>
+        class FlatHashTable
+        {
+            protected:
+                /*
+                 * @brief The slots, the capacity is 0 or a power of 2.
+                */
+                std::vector<Slot> _slots;
+
+                /*
+                 * @brief The number of keys in the table.
+                */
+                std::size_t _size = 0;
+
+                /*
+                 * @brief The hash function.
+                */
+                Hash _hash;
+
+                /*
+                 * @brief The capacity of the first allocation.
+                */
+                static constexpr std::size_t min_capacity = 16;
+
+                /*
+                 * @brief The maximal load factor, as a ratio (3/4).
+                */
+                static constexpr std::size_t max_load_num = 3, max_load_den = 4;
+
+                /*
+                 * @brief Builds the key of an empty slot.
+                 * @note This function is static because it is only used internally and doesn't require an instance of the class.
+                */
+                static constexpr Key _empty_key() noexcept {
+                    Key key;
+                    key._denominator = 0;
+                    return key;
+                }
+
+                /*
+                 * @brief Builds an empty slot (with a default value).
+                 * @note This function is static because it is only used internally and doesn't require an instance of the class.
+                */
+                static constexpr Slot _empty_slot() {
+                    Slot slot{};
+                    slot.key = _empty_key();
+                    return slot;
+                }
+
+                /*
+                 * @brief Checks if a slot is empty.
+                 * @note This function is static because it is only used internally and doesn't require an instance of the class.
+                */
+                static constexpr bool _is_empty(const Slot& slot) noexcept {
+                    return slot.key._denominator == 0;
+                }
+
+                /*
+                 * @brief Gets the home slot of a key.
+                */
+                std::size_t _home(const Key& key) const {
+                    return _hash(key) & (_slots.size() - 1);
+                }
+
+                /*
+                 * @brief Finds the slot of a key, or the empty slot where it would be inserted.
+                 * @param key The key.
+                 * @return std::size_t The index of the slot (the table must not be empty).
+                */
+                std::size_t _probe(const Key& key) const {
+                    const std::size_t mask = _slots.size() - 1;
+                    std::size_t index = _home(key);
+
+                    while (!_is_empty(_slots[index]) && !(_slots[index].key == key))
+                        index = (index + 1) & mask;
+
+                    return index;
+                }
+
+                /*
+                 * @brief Finds the slot of a key.
+                 * @param key The key.
+                 * @return Slot* The slot, or nullptr if the key isn't in the table.
+                */
+                const Slot* _find(const Key& key) const {
+                    if (_size == 0)
+                        return nullptr;
+
+                    const Slot& slot = _slots[_probe(key)];
+                    return _is_empty(slot) ? nullptr : &slot;
+                }
+
+                /*
+                 * @brief Finds the slot of a key.
+                 * @param key The key.
+                 * @return Slot* The slot, or nullptr if the key isn't in the table.
+                */
+                Slot* _find(const Key& key) {
+                    return const_cast<Slot*>(std::as_const(*this)._find(key));
+                }
+
+                /*
+                 * @brief Inserts a key, unless it is already in the table.
+                 * @param key The key.
+                 * @return std::pair<Slot&, bool> The slot of the key, and true if it was inserted.
+                */
+                std::pair<Slot&, bool> _insert(const Key& key) {
+                    if ((_size + 1) * max_load_den > _slots.size() * max_load_num)
+                        _rehash(std::max(min_capacity, _slots.size() * 2));
+
+                    Slot& slot = _slots[_probe(key)];
+
+                    if (!_is_empty(slot))
+                        return {slot, false};
+
+                    slot.key = key;
+                    ++_size;
+                    return {slot, true};
+                }
+
+                /*
+                 * @brief Moves every key to a table of a new capacity.
+                 * @param capacity The new capacity (a power of 2, larger than the number of keys).
+                */
+                void _rehash(std::size_t capacity) {
+                    std::vector<Slot> old(capacity, _empty_slot());
+                    _slots.swap(old);
+
+                    for (Slot& slot : old)
+                    {
+                        if (!_is_empty(slot))
+                            _slots[_probe(slot.key)] = std::move(slot);
+                    }
+                }
+
+                /*
+                 * @brief Calls a function on every occupied slot.
+                */
+                template <typename Self, typename Func>
+                static void _for_each(Self& self, Func& func) {
+                    for (auto& slot : self._slots)
+                    {
+                        if (!_is_empty(slot))
+                            func(slot);
+                    }
+                }
+
+            public:
+                /*
+                 * @brief Gets the number of keys.
+                 * @return std::size_t The number of keys.
+                */
+                std::size_t size() const { return _size; }
+
+                /*
+                 * @brief Checks if there are no keys.
+                 * @return True if the table is empty, false otherwise.
+                */
+                bool empty() const { return _size == 0; }
+
+                /*
+                 * @brief Gets the number of slots.
+                 * @return std::size_t The number of slots (0 or a power of 2).
+                */
+                std::size_t capacity() const { return _slots.size(); }
+
+                /*
+                 * @brief Checks if a key is in the table.
+                 * @param key The key.
+                 * @return True if the key is in the table, false otherwise.
+                */
+                bool contains(const Key& key) const { return _find(key) != nullptr; }
+
+                /*
+                 * @brief Removes every key (the slots are kept).
+                */
+                void clear() {
+                    std::fill(_slots.begin(), _slots.end(), _empty_slot());
+                    _size = 0;
+                }
+
+                /*
+                 * @brief Makes room for a number of keys without rehashing.
+                 * @param count The number of keys.
+                */
+                void reserve(std::size_t count) {
+                    std::size_t capacity = min_capacity;
+
+                    while (count * max_load_den > capacity * max_load_num)
+                        capacity *= 2;
+
+                    if (capacity > _slots.size())
+                        _rehash(capacity);
+                }
+
+                /*
+                 * @brief Removes a key.
+                 * @param key The key.
+                 * @return True if the key was removed, false if it wasn't in the table.
+                */
+                bool erase(const Key& key) {
+                    if (_size == 0)
+                        return false;
+
+                    const std::size_t mask = _slots.size() - 1;
+                    std::size_t hole = _probe(key);
+
+                    if (_is_empty(_slots[hole]))
+                        return false;
+
+                    // Shift back every following entry whose home isn't cyclically in (hole, next].
+                    for (std::size_t next = (hole + 1) & mask; !_is_empty(_slots[next]); next = (next + 1) & mask)
+                    {
+                        const std::size_t home = _home(_slots[next].key);
+
+                        if (((next - home) & mask) >= ((next - hole) & mask))
+                        {
+                            _slots[hole] = std::move(_slots[next]);
+                            hole = next;
+                        }
+                    }
+
+                    _slots[hole] = _empty_slot();
+                    --_size;
+                    return true;
+                }
+        };
+
+        /*
+         * @brief A slot of FlatHashMap.
+        */
+        template <typename Key, typename Value>
+        struct FlatMapSlot
+        {
+            Key key;
+            Value value;
+        };
+
+        /*
+         * @brief A slot of FlatHashSet.
+        */
+        template <typename Key>
+        struct FlatSetSlot
+        {
+            Key key;
+        };
+    }
+
+    /*
+     * @brief A flat (open addressing) hash map keyed by fractions.
+     * @note Key is a BasicFraction, Value must be default constructible (empty slots hold a default value).
+     * @note Inserting may move the entries, so pointers to values are invalidated by insertions and erasures.
+    */
+    template <typename Key, typename Value, typename Hash = std::hash<Key>>
+    class FlatHashMap : public detail::FlatHashTable<Key, detail::FlatMapSlot<Key, Value>, Hash>
+    {
+        private:
+            using _Table = detail::FlatHashTable<Key, detail::FlatMapSlot<Key, Value>, Hash>;
+
+        public:
+            /*
+             * @brief Gets the value of a key, inserting a default value if the key is missing.
+             * @param key The key.
+             * @return Value& The value of the key.
+            */
+            Value& operator[](const Key& key) {
+                return this->_insert(key).first.value;
+            }
+
+            /*
+             * @brief Inserts a key and a value, unless the key is already in the map.
+             * @param key The key.
+             * @param value The value.
+             * @return True if the key was inserted, false if it was already in the map (its value is kept).
+            */
+            bool insert(const Key& key, Value value) {
+                auto [slot, inserted] = this->_insert(key);
+
+                if (inserted)
+                    slot.value = std::move(value);
+
+                return inserted;
+            }
+
+            /*
+             * @brief Finds the value of a key.
+             * @param key The key.
+             * @return Value* The value, or nullptr if the key isn't in the map.
+            */
+            Value* find(const Key& key) {
+                auto* slot = this->_find(key);
+                return (slot == nullptr) ? nullptr : &slot->value;
+            }
+
+            /*
+             * @brief Finds the value of a key.
+             * @param key The key.
+             * @return const Value* The value, or nullptr if the key isn't in the map.
+            */
+            const Value* find(const Key& key) const {
+                const auto* slot = this->_find(key);
+                return (slot == nullptr) ? nullptr : &slot->value;
+            }
+
+            /*
+             * @brief Calls func(key, value) on every entry, in no particular order.
+             * @param func The function, it may modify the values but not the map.
+            */
+            template <typename Func>
+            void for_each(Func func) {
+                auto call = [&](auto& slot) { func(static_cast<const Key&>(slot.key), slot.value); };
+                _Table::_for_each(*this, call);
+            }
+
+            /*
+             * @brief Calls func(key, value) on every entry, in no particular order.
+             * @param func The function.
+            */
+            template <typename Func>
+            void for_each(Func func) const {
+                auto call = [&](const auto& slot) { func(slot.key, slot.value); };
+                _Table::_for_each(*this, call);
+            }
+    };
+
+    /*
+     * @brief A flat (open addressing) hash set of fractions.
+     * @note Key is a BasicFraction.
+    */
+    template <typename Key, typename Hash = std::hash<Key>>
+    class FlatHashSet : public detail::FlatHashTable<Key, detail::FlatSetSlot<Key>, Hash>
+    {
+        private:
+            using _Table = detail::FlatHashTable<Key, detail::FlatSetSlot<Key>, Hash>;
+
+        public:
+            /*
+             * @brief Inserts a key.
+             * @param key The key.
+             * @return True if the key was inserted, false if it was already in the set.
+            */
+            bool insert(const Key& key) {
+                return this->_insert(key).second;
+            }
+
+            /*
+             * @brief Calls func(key) on every key, in no particular order.
+             * @param func The function, it must not modify the set.
+            */
+            template <typename Func>
+            void for_each(Func func) const {
+                auto call = [&](const auto& slot) { func(slot.key); };
+                _Table::_for_each(*this, call);
+            }
+    };
+}
@@ -15,269 +15,142 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include <array>
+#include <cctype>
 #include "Fraction.hpp"
 
 namespace ariel
 {
-    Fraction::Fraction(): _numerator(0), _denominator(1) {}
-
-    Fraction::Fraction(float number): _numerator(static_cast<int>(1000 * number)), _denominator(1000) {
-        _reduce();
-    }
-
-    Fraction::Fraction(int numerator, int denominator): _numerator(numerator), _denominator(denominator) {
-        if (denominator == 0)
-            throw std::invalid_argument("Denominator can't be zero");
-
-        if (denominator < 0)
-        {
-            _numerator *= -1;
-            _denominator *= -1;
+    namespace
+    {
+        /*
+         * @brief Writes an integer to the output stream.
+         * @note int128_t has no standard stream operator, so it is converted digit by digit.
+        */
+        template <typename IntT>
+        void write_integer(std::ostream& outstream, IntT num) {
+            if constexpr (std::numeric_limits<IntT>::digits > std::numeric_limits<long long>::digits)
+            {
+                constexpr int base = 10;
+                constexpr std::size_t max_digits = std::numeric_limits<IntT>::digits10 + 2;
+                std::array<char, max_digits> digits{};
+                std::size_t pos = max_digits;
+                bool negative = num < 0;
+                auto magnitude = negative ? static_cast<uint128_t>(0 - static_cast<uint128_t>(num)) : static_cast<uint128_t>(num);
+
+                do
+                {
+                    digits[--pos] = static_cast<char>('0' + static_cast<int>(magnitude % base));
+                    magnitude /= base;
+                } while (magnitude != 0);
+
+                if (negative)
+                    digits[--pos] = '-';
+
+                outstream.write(digits.data() + pos, static_cast<std::streamsize>(max_digits - pos));
+            }
+
+            else
+                outstream << num;
         }
 
-        _reduce();
-    }
-
-    Fraction::Fraction(const Fraction& other): _numerator(other._numerator), _denominator(other._denominator) {}
-
-    Fraction::Fraction(Fraction&& other) noexcept: _numerator(other._numerator), _denominator(other._denominator) {}
-
-    int Fraction::getNumerator() const {
-        return _numerator;
-    }
-
-    int Fraction::getDenominator() const {
-        return _denominator;
-    }
-
-    Fraction& Fraction::operator=(const Fraction& other) {
-        if (this == &other)
-            return *this;
-        
-        this->_numerator = other._numerator;
-        this->_denominator = other._denominator;
-        return *this;
-    }
-
-    Fraction& Fraction::operator=(Fraction&& other) noexcept {
-        if (this == &other)
-            return *this;
-
-        this->_numerator = other._numerator;
-        this->_denominator = other._denominator;
-        return *this;
+        /*
+         * @brief Reads an integer from the input stream.
+         * @note int128_t has no standard stream operator, so it is parsed digit by digit
+         *       (leading whitespace, an optional sign and at least one digit), setting failbit on errors and overflow.
+        */
+        template <typename IntT>
+        void read_integer(std::istream& inptstream, IntT& num) {
+            if constexpr (std::numeric_limits<IntT>::digits > std::numeric_limits<long long>::digits)
+            {
+                constexpr int base = 10;
+                uint128_t magnitude = 0;
+                uint128_t limit = static_cast<uint128_t>(std::numeric_limits<IntT>::max());
+                bool negative = false, any_digit = false;
+
+                inptstream >> std::ws;
+
+                if (inptstream.peek() == '-' || inptstream.peek() == '+')
+                    negative = (inptstream.get() == '-');
+
+                if (negative)
+                    ++limit;
+
+                while (std::isdigit(inptstream.peek()) != 0)
+                {
+                    auto digit = static_cast<uint128_t>(inptstream.get() - '0');
+
+                    if (magnitude > (limit - digit) / base)
+                    {
+                        inptstream.setstate(std::ios::failbit);
+                        return;
+                    }
+
+                    magnitude = magnitude * base + digit;
+                    any_digit = true;
+                }
+
+                if (!any_digit)
+                {
+                    inptstream.setstate(std::ios::failbit);
+                    return;
+                }
+
+                num = negative ? static_cast<IntT>(0 - magnitude) : static_cast<IntT>(magnitude);
+            }
+
+            else
+                inptstream >> num;
+        }
     }
 
 
     // Stream operators (IO friend functions)
 
-    std::ostream& operator<<(std::ostream& outstream, const Fraction& fraction) {
-        outstream << fraction._numerator << "/" << fraction._denominator;
+    template <typename IntT, typename Policy>
+    std::ostream& operator<<(std::ostream& outstream, const BasicFraction<IntT, Policy>& fraction) {
+        write_integer(outstream, fraction._numerator);
+        outstream << "/";
+        write_integer(outstream, fraction._denominator);
         return outstream;
     }
 
-    std::istream& operator>>(std::istream& inptstream, Fraction& fraction) {
-        int numitor = 0, denitor = 0;
+    template <typename IntT, typename Policy>
+    std::istream& operator>>(std::istream& inptstream, BasicFraction<IntT, Policy>& fraction) {
+        IntT numitor = 0, denitor = 0;
 
-        inptstream >> numitor >> denitor;
+        read_integer(inptstream, numitor);
+        read_integer(inptstream, denitor);
 
         if (inptstream.fail())
-            throw std::runtime_error("Invalid input");
+            ARIEL_FRACTION_THROW(std::runtime_error("Invalid input"));
 
         else if (denitor == 0)
-            throw std::runtime_error("Denominator can't be zero");
-
-        else if (denitor < 0)
-        {
-            numitor *= -1;
-            denitor *= -1;
-        }
+            ARIEL_FRACTION_THROW(std::runtime_error("Denominator can't be zero"));
 
-        fraction._numerator = numitor;
-        fraction._denominator = denitor;
-        fraction._reduce();
+        // The constructor reduces before fixing the sign, so min_int parts don't overflow.
+        fraction = BasicFraction<IntT, Policy>(numitor, denitor);
 
         return inptstream;
 	}
 
+    // Explicit instantiations for every integer type and overflow policy.
 
-    // Operators with fractions
-
-    const Fraction Fraction::operator+(const Fraction& other) const {
-        int a = _overflow_multiplication_check(_numerator, other._denominator);
-        int b = _overflow_multiplication_check(other._numerator, _denominator);
-        
-        int numerator = _overflow_addition_check(a, b);
-        int denominator = _overflow_multiplication_check(_denominator, other._denominator);
-
-        return Fraction(numerator, denominator);
-    }
-
-    const Fraction Fraction::operator-(const Fraction& other) const {
-        int a = _overflow_multiplication_check(_numerator, other._denominator);
-        int b = _overflow_multiplication_check(other._numerator, _denominator);
-        
-        int numerator = _overflow_subtraction_check(a, b);
-        int denominator = _overflow_multiplication_check(_denominator, other._denominator);
-
-        return Fraction(numerator, denominator);
-    }
-
-    const Fraction Fraction::operator*(const Fraction& other) const {
-        int numerator = _overflow_multiplication_check(_numerator, other._numerator);
-        int denominator = _overflow_multiplication_check(_denominator, other._denominator);
-
-        return Fraction(numerator, denominator);
-    }
-
-    const Fraction Fraction::operator/(const Fraction& other) const {
-        if (other._numerator == 0)
-            throw std::runtime_error("Can't divide by zero");
-
-        int numerator = _overflow_multiplication_check(_numerator, other._denominator);
-        int denominator = _overflow_multiplication_check(_denominator, other._numerator);
-
-        return Fraction(numerator, denominator);
-    }
-
-    Fraction& Fraction::operator++() {
-        _numerator += _denominator;
-
-        _reduce();
-
-        return *this;
-    }
-
-    Fraction Fraction::operator++(int) {
-        Fraction temp = *this;
-        ++(*this);
-        return temp;
-    }
-
-    Fraction& Fraction::operator--() {
-        _numerator -= _denominator;
-
-        _reduce();
-
-        return *this;
-    }
-
-    Fraction Fraction::operator--(int) {
-        Fraction temp = *this;
-        --(*this);
-        return temp;
-    }
-
-    bool Fraction::operator==(const Fraction& other) const {
-        return (_numerator == other._numerator) && (_denominator == other._denominator);
-    }
+#define ARIEL_INSTANTIATE_STREAM_OPERATORS(IntT, Policy) \
+    template std::ostream& operator<< <IntT, Policy>(std::ostream& outstream, const BasicFraction<IntT, Policy>& fraction); \
+    template std::istream& operator>> <IntT, Policy>(std::istream& inptstream, BasicFraction<IntT, Policy>& fraction);
 
-    bool Fraction::operator!=(const Fraction& other) const {
-        return !(*this == other);
-    }
+#define ARIEL_INSTANTIATE_STREAM_OPERATORS_FOR_POLICY(Policy) \
+    ARIEL_INSTANTIATE_STREAM_OPERATORS(int, Policy) \
+    ARIEL_INSTANTIATE_STREAM_OPERATORS(long, Policy) \
+    ARIEL_INSTANTIATE_STREAM_OPERATORS(long long, Policy) \
+    ARIEL_INSTANTIATE_STREAM_OPERATORS(int128_t, Policy)
 
-    bool Fraction::operator<(const Fraction& other) const {
-        return (_numerator * other._denominator) < (other._numerator * _denominator);
-    }
+    ARIEL_INSTANTIATE_STREAM_OPERATORS_FOR_POLICY(overflow::ThrowOnOverflow)
+    ARIEL_INSTANTIATE_STREAM_OPERATORS_FOR_POLICY(overflow::SaturateOnOverflow)
+    ARIEL_INSTANTIATE_STREAM_OPERATORS_FOR_POLICY(overflow::FlagOnOverflow)
+    ARIEL_INSTANTIATE_STREAM_OPERATORS_FOR_POLICY(overflow::UncheckedOverflow)
 
-    bool Fraction::operator>(const Fraction& other) const {
-        return (_numerator * other._denominator) > (other._numerator * _denominator);
-    }
-
-    bool Fraction::operator<=(const Fraction& other) const {
-        return !(*this > other);
-    }
-
-    bool Fraction::operator>=(const Fraction& other) const {
-        return !(*this < other);
-    }
-
-
-    // Operators with floats
-
-    const Fraction Fraction::operator+(const float& other) const {
-        return *this + Fraction(other);
-    }
-    
-    const Fraction operator+(const float& num, const Fraction& other) {
-        return Fraction(num) + other;
-    }
-
-    const Fraction Fraction::operator-(const float& other) const  {
-        return *this - Fraction(other);
-    }
-
-    const Fraction operator-(const float& num, const Fraction& other) {
-        return Fraction(num) - other;
-    }
-
-    const Fraction Fraction::operator*(const float& other) const {
-        return *this * Fraction(other);
-    }
-
-    const Fraction operator*(const float& num, const Fraction& other) {
-        return Fraction(num) * other;
-    }
-
-    const Fraction Fraction::operator/(const float& other) const  {
-        if (other == 0.0)
-            throw std::runtime_error("Can't divide by zero");
-
-        return *this / Fraction(other);
-    }
-
-    const Fraction operator/(const float& num, const Fraction& other) {
-        if (other._numerator == 0)
-            throw std::runtime_error("Can't divide by zero");
-
-        return Fraction(num) / other;
-    }
-
-    bool Fraction::operator==(const float& other) const {
-        return *this == Fraction(other);
-    }
-
-    bool operator==(const float& num, const Fraction& other) {
-        return Fraction(num) == other;
-    }
-
-    bool Fraction::operator!=(const float& other) const {
-        return !(*this == Fraction(other));
-    }
-
-    bool operator!=(const float& num, const Fraction& other) {
-        return !(Fraction(num) == other);
-    }
-
-    bool Fraction::operator<(const float& other) const {
-        return *this < Fraction(other);
-    }
-
-    bool operator<(const float& num, const Fraction& other) {
-        return Fraction(num) < other;
-    }
-
-    bool Fraction::operator>(const float& other) const {
-        return *this > Fraction(other);
-    }
-
-    bool operator>(const float& num, const Fraction& other) {
-        return Fraction(num) > other;
-    }
-
-    bool Fraction::operator<=(const float& other) const {
-        return !(*this > Fraction(other));
-    }
-
-    bool operator<=(const float& num, const Fraction& other) {
-        return !(Fraction(num) > other);
-    }
-
-    bool Fraction::operator>=(const float& other) const {
-        return !(*this < Fraction(other));
-    }
-
-    bool operator>=(const float& num, const Fraction& other) {
-        return !(Fraction(num) < other);
-    }
+#undef ARIEL_INSTANTIATE_STREAM_OPERATORS_FOR_POLICY
+#undef ARIEL_INSTANTIATE_STREAM_OPERATORS
 }
\ No newline at end of file
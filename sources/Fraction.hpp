@@ -1,7 +1,7 @@
 /*
  *  Software Systems CPP Course Assignment 3
  *  Copyright (C) 2023  Roy Simanovich
- * 
+ *
  *  This program is free software: you can redistribute it and/or modify
  *  it under the terms of the GNU General Public License as published by
  *  the Free Software Foundation, either version 3 of the License, or
@@ -10,151 +10,945 @@
  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
  *  GNU General Public License for more details.
- * 
+ *
  *  You should have received a copy of the GNU General Public License
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <sstream>
 #include <fstream>
+#include <functional>
+#include <initializer_list>
 #include <limits>
+#include <span>
+#include "GCD.hpp"
+#include "OverflowPolicy.hpp"
+#include "Result.hpp"
 
 namespace ariel
 {
-    class Fraction
+    namespace detail
+    {
+        /*
+         * @brief The integer types a BasicFraction is built from.
+         * @note unsigned_type is used for magnitudes and gcds.
+         * @note wide_type holds the intermediate results of the arithmetic operators. It is twice as wide as
+         *       the fraction's integer type, except for int128_t, where no wider type exists and the
+         *       intermediate operations are overflow checked instead.
+        */
+        template <typename IntT>
+        struct fraction_int_traits;
+
+        template <>
+        struct fraction_int_traits<int> { using unsigned_type = unsigned int; using wide_type = long long; };
+
+        template <>
+        struct fraction_int_traits<long> { using unsigned_type = unsigned long; using wide_type = int128_t; };
+
+        template <>
+        struct fraction_int_traits<long long> { using unsigned_type = unsigned long long; using wide_type = int128_t; };
+
+        template <>
+        struct fraction_int_traits<int128_t> { using unsigned_type = uint128_t; using wide_type = int128_t; };
+
+        /*
+         * @brief The non-float operand types with dedicated mixed operators: every integer type but bool
+         *        (including int128_t) goes through the integer kernels, double and long double through the rounded k / 1000 kernels.
+         * @note std::numeric_limits is used because std::is_integral doesn't accept int128_t in strict ISO mode.
+        */
+        template <typename Number>
+        concept fraction_scalar = (std::numeric_limits<Number>::is_integer && !std::is_same_v<Number, bool>)
+            || (std::is_floating_point_v<Number> && !std::is_same_v<Number, float>);
+
+        /*
+         * @brief Mixes the bits of a 64-bit number (the splitmix64 finalizer).
+         * @param num The number.
+         * @return std::uint64_t The mixed number, every input bit affects every output bit.
+         * @note It is a bijection, so distinct inputs never collide.
+        */
+        constexpr std::uint64_t hash_mix(std::uint64_t num) noexcept {
+            num = (num ^ (num >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            num = (num ^ (num >> 27)) * 0x94d049bb133111ebULL;
+            return num ^ (num >> 31);
+        }
+
+        /*
+         * @brief Hashes a reduced numerator and denominator.
+         * @param numerator The numerator.
+         * @param denominator The denominator.
+         * @return std::uint64_t The hash.
+         * @note Parts of up to 32 bits are packed into a single 64-bit word and mixed once, so two int fractions
+         *       never have the same hash. The 64-bit words of wider parts are mixed in one after another.
+        */
+        template <typename IntT>
+        constexpr std::uint64_t hash_fraction(IntT numerator, IntT denominator) noexcept {
+            using UIntT = typename fraction_int_traits<IntT>::unsigned_type;
+            constexpr int word_bits = std::numeric_limits<std::uint64_t>::digits;
+            constexpr int half_bits = word_bits / 2;
+
+            if constexpr (std::numeric_limits<UIntT>::digits <= half_bits)
+                return hash_mix(static_cast<std::uint64_t>(static_cast<UIntT>(numerator)) << half_bits | static_cast<UIntT>(denominator));
+
+            else
+            {
+                std::uint64_t hash = 0;
+
+                for (const UIntT part : {static_cast<UIntT>(numerator), static_cast<UIntT>(denominator)})
+                {
+                    for (int shift = 0; shift < std::numeric_limits<UIntT>::digits; shift += word_bits)
+                        hash = hash_mix(hash ^ static_cast<std::uint64_t>(part >> shift));
+                }
+
+                return hash;
+            }
+        }
+
+        /*
+         * @brief The open addressing table behind FlatHashMap and FlatHashSet (see FlatHashMap.hpp).
+        */
+        template <typename Key, typename Slot, typename Hash>
+        class FlatHashTable;
+    }
+
+    template <typename IntT, typename Policy = overflow::ThrowOnOverflow>
+    class BasicFraction;
+
+    template <typename IntT, typename Policy>
+    class BasicFractionAccumulator;
+
+    template <typename IntT>
+    class BasicLazyFraction;
+
+    class BigFraction;
+
+    class FractionArray;
+
+    /*
+     * @brief Prints the fraction to the output stream.
+     * @note Defined (and explicitly instantiated) in Fraction.cpp.
+    */
+    template <typename IntT, typename Policy>
+    std::ostream& operator<<(std::ostream& outstream, const BasicFraction<IntT, Policy>& fraction);
+
+    /*
+     * @brief Reads the fraction from the input stream.
+     * @note Defined (and explicitly instantiated) in Fraction.cpp.
+    */
+    template <typename IntT, typename Policy>
+    std::istream& operator>>(std::istream& inptstream, BasicFraction<IntT, Policy>& fraction);
+
+    /*
+     * @brief A fraction of two integers of type IntT (int, long, long long or int128_t).
+     * @note ariel::Fraction is the int instantiation.
+     * @note Policy picks what an overflowing operation does (throw, saturate, flag or nothing), see OverflowPolicy.hpp.
+    */
+    template <typename IntT, typename Policy>
+    class BasicFraction
     {
+        public:
+            /*
+             * @brief The integer type of the numerator and the denominator.
+            */
+            using int_type = IntT;
+
+            /*
+             * @brief The overflow policy of the fraction.
+            */
+            using policy_type = Policy;
+
         private:
+            /*
+             * @brief The unsigned integer type of the same width, used for magnitudes and gcds.
+            */
+            using UIntT = typename detail::fraction_int_traits<IntT>::unsigned_type;
+
+            /*
+             * @brief The (usually twice as wide) integer type of the intermediate results.
+            */
+            using WideT = typename detail::fraction_int_traits<IntT>::wide_type;
+
+            /*
+             * @brief The unsigned type of WideT.
+            */
+            using UWideT = typename detail::fraction_int_traits<WideT>::unsigned_type;
+
+            /*
+             * @brief True if WideT is wider than IntT, so products of two IntT values can't overflow it.
+            */
+            static constexpr bool _is_widened = std::numeric_limits<WideT>::digits > std::numeric_limits<IntT>::digits;
+
             /*
              * @brief The numerator of the fraction.
              * @note The numerator is the top number of the fraction.
             */
-            int _numerator;
-            
+            IntT _numerator;
+
             /*
              * @brief The denominator of the fraction.
              * @note The denominator is the bottom number of the fraction.
              * @note The denominator can't be 0.
             */
-            int _denominator;
+            IntT _denominator;
 
             /*
-             * @brief A constant that represents the maximum value of an int.
+             * @brief A constant that represents the maximum value of IntT.
              * @note This constant is used to check for overflow.
             */
-            static const int max_int = std::numeric_limits<int>::max();
+            static constexpr IntT max_int = std::numeric_limits<IntT>::max();
 
             /*
-             * @brief A constant that represents the minimum value of an int.
+             * @brief A constant that represents the minimum value of IntT.
              * @note This constant is used to check for overflow.
             */
-            static const int min_int = std::numeric_limits<int>::min();
+            static constexpr IntT min_int = std::numeric_limits<IntT>::min();
 
             /*
              * @brief Reduces the fraction to its simplest form.
              * @note This function is private because it is only used internally.
             */
-            void _reduce() {
-                auto gcd_fact = _gcd(abs(_numerator), abs(_denominator));
+            constexpr void _reduce() {
+                auto gcd_fact = _gcd(_numerator, _denominator);
                 _numerator /= gcd_fact;
                 _denominator /= gcd_fact;
             }
 
             /*
-             * @brief Reduces the fraction to its simplest form.
+             * @brief Reduces a widened fraction to its simplest form.
              * @param numerator The numerator of the fraction.
              * @param denominator The denominator of the fraction.
              * @note This function is private because it is only used internally.
              * @note This function is static because it is only used internally and doesn't require an instance of the class.
             */
-            static void _reduce(int& numerator, int& denominator) {
-                auto gcd_fact = _gcd(abs(numerator), abs(denominator));
+            static constexpr void _reduce(WideT& numerator, WideT& denominator) {
+                auto gcd_fact = static_cast<WideT>(_gcd_wide(_magnitude(numerator), _magnitude(denominator)));
                 numerator /= gcd_fact;
                 denominator /= gcd_fact;
             }
 
             /*
-             * @brief Calculates the greatest common divisor of two numbers.
+             * @brief Calculates the greatest common divisor of two widened numbers.
              * @param num1 The first number.
              * @param num2 The second number.
-             * @return int The greatest common divisor of the two numbers.
+             * @return UWideT The greatest common divisor of the two numbers.
+             * @note Falls back to the cheaper narrow engine when both numbers fit in UIntT.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            static constexpr UWideT _gcd_wide(UWideT num1, UWideT num2) {
+                if constexpr (_is_widened)
+                {
+                    if (((num1 | num2) >> std::numeric_limits<UIntT>::digits) == 0)
+                        return gcd::gcd(static_cast<UIntT>(num1), static_cast<UIntT>(num2));
+                }
+
+                return gcd::gcd(num1, num2);
+            }
+
+            /*
+             * @brief Calculates the absolute value of a number as an unsigned number.
+             * @param num The number (IntT or WideT).
+             * @return The absolute value of the number (well defined for the minimum value too).
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            template <typename T>
+            static constexpr auto _magnitude(T num) {
+                using U = typename detail::fraction_int_traits<T>::unsigned_type;
+                return (num < 0) ? static_cast<U>(U{0} - static_cast<U>(num)) : static_cast<U>(num);
+            }
+
+            /*
+             * @brief Calculates the greatest common divisor of two numbers.
+             * @param num1 The first number (its sign is ignored).
+             * @param num2 The second number (its sign is ignored).
+             * @return IntT The greatest common divisor of the two numbers.
              * @note This function is used to reduce the fraction to its simplest form.
              * @note This function is static because it is only used internally and doesn't require an instance of the class.
+             * @note The engine (Euclid, binary or Lehmer) is selected at compile time with ARIEL_GCD_ENGINE, see GCD.hpp.
             */
-            static int _gcd(int num1, int num2) {
-                return (num2 == 0) ? num1:_gcd(num2, num1 % num2);
+            static constexpr IntT _gcd(IntT num1, IntT num2) {
+                return static_cast<IntT>(gcd::gcd(_magnitude(num1), _magnitude(num2)));
             }
 
             /*
-             * @brief Checks if the addition of two numbers will cause an overflow.
-             * @param num1 The first number.
-             * @param num2 The second number.
-             * @return The result of the addition.
-             * @throw overflow_error if the addition will cause an overflow.
+             * @brief Builds a fraction from parts that are stored as is, without the checks of the trusted constructor.
+             * @param numerator The numerator (truncated to IntT).
+             * @param denominator The denominator (truncated to IntT).
+             * @return BasicFraction The wrapped result of an overflow, which the non-throwing policies may keep.
              * @note This function is static because it is only used internally and doesn't require an instance of the class.
             */
-            static int _overflow_addition_check(int num1, int num2) {
-                if ((num2 > 0 && num1 > (max_int - num2)) || (num2 < 0 && num1 < (min_int - num2)))
+            template <typename T>
+            static constexpr BasicFraction _wrapped(T numerator, T denominator) noexcept {
+                BasicFraction result;
+                result._numerator = static_cast<IntT>(numerator);
+                result._denominator = static_cast<IntT>(denominator);
+                return result;
+            }
+
+            /*
+             * @brief Saturates an exact value that doesn't fit in IntT to the nearest fraction that does.
+             * @param magnitude The magnitude of the numerator (reduced).
+             * @param denominator The denominator (positive).
+             * @param negative The sign of the value.
+             * @return BasicFraction +-max_int / 1 beyond the range, otherwise the best approximation with parts up to max_int
+             *         (so 0 / 1 or +-1 / max_int for values closer to 0 than any fraction of IntT).
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            template <typename T>
+            static constexpr BasicFraction _saturate(T magnitude, T denominator, bool negative) {
+                using U = std::conditional_t<(std::numeric_limits<T>::digits > std::numeric_limits<std::uint64_t>::digits), uint128_t, std::uint64_t>;
+                const auto num = static_cast<U>(magnitude), den = static_cast<U>(denominator);
+
+                if (num / den >= static_cast<U>(max_int))
+                    return BasicFraction(negative ? -max_int : max_int, 1, _reduced_tag{});
+
+                return _best_approximation<U>(num, den, static_cast<U>(max_int), static_cast<U>(max_int), negative);
+            }
+
+            /*
+             * @brief Saturates a value known only approximately (an intermediate result overflowed) to a fraction of IntT.
+             * @param value The value.
+             * @return BasicFraction +-max_int / 1 beyond the range, otherwise the best approximation of the value as a double.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            static constexpr BasicFraction _saturate_approximation(long double value) {
+                const auto approximation = static_cast<double>(value);
+
+                if (!(((approximation < 0) ? -approximation : approximation) < static_cast<double>(max_int)))
+                    return BasicFraction((approximation < 0) ? -max_int : max_int, 1, _reduced_tag{});
+
+                return from_double_rounded(approximation);
+            }
+
+            /*
+             * @brief Builds the result of an operation from its reduced parts, which may not fit in IntT.
+             * @param numerator The numerator (reduced, IntT or a wider type).
+             * @param denominator The denominator (positive).
+             * @return BasicFraction The fraction, or if it doesn't fit, the policy's result: ThrowOnOverflow throws,
+             *         SaturateOnOverflow returns the saturated value (see _saturate()) and the others the wrapped parts.
+             * @throw overflow_error if the fraction doesn't fit in IntT (with the default policy).
+             * @note The whole value is resolved, not each part: clamping the parts separately changes the value arbitrarily.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            template <typename T>
+            static constexpr BasicFraction _narrow_fraction(T numerator, T denominator) {
+                if constexpr (Policy::checked && std::numeric_limits<T>::digits > std::numeric_limits<IntT>::digits)
                 {
-                    throw std::overflow_error("Addition overflow");
+                    if (numerator > max_int || numerator < min_int || denominator > max_int)
+                        return Policy::resolve(true, _wrapped(numerator, denominator), [=] {
+                            return _saturate(_magnitude(numerator), _magnitude(denominator), numerator < 0);
+                        }, "Fraction overflow");
                 }
 
-                return (num1 + num2);
+                return BasicFraction(static_cast<IntT>(numerator), static_cast<IntT>(denominator), _reduced_tag{});
             }
 
             /*
-             * @brief Checks if the subtraction of two numbers will cause an overflow.
-             * @param num1 The first number.
-             * @param num2 The second number.
-             * @return The result of the subtraction.
-             * @throw overflow_error if the subtraction will cause an overflow.
+             * @brief Builds the result of an operation whose intermediate results may have overflowed WideT.
+             * @param numerator The numerator (reduced if nothing overflowed).
+             * @param denominator The denominator (positive if nothing overflowed).
+             * @param overflowed True if an intermediate result overflowed (the parts are then meaningless).
+             * @param approximation Returns the exact result as a long double, it's only called to saturate an overflow.
+             * @param message The message of an intermediate overflow.
+             * @return BasicFraction The fraction, or the policy's result (see above).
              * @note This function is static because it is only used internally and doesn't require an instance of the class.
             */
-            static int _overflow_subtraction_check(int num1, int num2) {
-                if ((num2 < 0 && num1 > max_int + num2) || (num2 > 0 && num1 < min_int + num2))
+            template <typename Approximation>
+            static constexpr BasicFraction _narrow_fraction(WideT numerator, WideT denominator, bool overflowed, Approximation approximation, const char* message) {
+                if constexpr (Policy::checked)
                 {
-                    throw std::overflow_error("Subtraction overflow");
+                    if (overflowed)
+                        return Policy::resolve(true, _wrapped(numerator, denominator), [=] { return _saturate_approximation(approximation()); }, message);
                 }
 
-                return (num1 - num2);
+                return _narrow_fraction(numerator, denominator);
             }
 
             /*
-             * @brief Checks if the multiplication of two numbers will cause an overflow.
+             * @brief Multiplies two widened numbers.
              * @param num1 The first number.
              * @param num2 The second number.
-             * @return The result of the multiplication.
-             * @throw overflow_error if the multiplication will cause an overflow.
+             * @param overflowed Set if WideT isn't wider than IntT and the multiplication overflows (the result wraps around).
+             * @return WideT The result of the multiplication.
+             * @note When WideT is twice as wide as IntT, products of IntT values always fit and no check is made.
              * @note This function is static because it is only used internally and doesn't require an instance of the class.
             */
-            static int _overflow_multiplication_check(int num1, int num2) {
-                if ((num2 > 0 && num1 > max_int / num2) || (num2 < 0 && num1 < max_int / num2))
+            static constexpr WideT _mul(WideT num1, WideT num2, bool& overflowed) {
+                if constexpr (_is_widened)
+                    return num1 * num2;
+
+                else
                 {
-                    throw std::overflow_error("Multiplication overflow");
+                    WideT result{};
+                    overflowed = __builtin_mul_overflow(num1, num2, &result) || overflowed;
+                    return result;
                 }
-
-                return (num1 * num2);
             }
 
             /*
-             * @brief Checks if the division of two numbers will cause an overflow.
+             * @brief Adds two widened numbers.
              * @param num1 The first number.
              * @param num2 The second number.
-             * @return The result of the division.
-             * @throw overflow_error if the division will cause an overflow.
+             * @param overflowed Set if WideT isn't wider than IntT and the addition overflows (the result wraps around).
+             * @return WideT The result of the addition.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            static constexpr WideT _add(WideT num1, WideT num2, bool& overflowed) {
+                if constexpr (_is_widened)
+                    return num1 + num2;
+
+                else
+                {
+                    WideT result{};
+                    overflowed = __builtin_add_overflow(num1, num2, &result) || overflowed;
+                    return result;
+                }
+            }
+
+            /*
+             * @brief Negates a widened number.
+             * @param num The number.
+             * @param overflowed Set if WideT isn't wider than IntT and the number is the minimum value.
+             * @return WideT The negated number.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            static constexpr WideT _negate(WideT num, bool& overflowed) {
+                if constexpr (_is_widened)
+                    return -num;
+
+                else
+                {
+                    WideT result{};
+                    overflowed = __builtin_sub_overflow(WideT{0}, num, &result) || overflowed;
+                    return result;
+                }
+            }
+
+            /*
+             * @brief The operand order of a sum of a fraction and another number: a + b, a - b or b - a.
+            */
+            enum class _Sum { Add, Subtract, Reverse };
+
+            /*
+             * @brief Approximates a sum of two numbers (for _narrow_fraction()).
+             * @param num1 The fraction a.
+             * @param num2 The other number b.
+             * @param sum The operand order.
+             * @return long double a + b, a - b or b - a.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            static constexpr long double _approximate_sum(long double num1, long double num2, _Sum sum) {
+                return (sum == _Sum::Add) ? num1 + num2 : (sum == _Sum::Subtract) ? num1 - num2 : num2 - num1;
+            }
+
+            /*
+             * @brief Three-way compares n1/d1 and n2/d2 with a continued fraction expansion.
+             * @param num1 The numerator of the first fraction.
+             * @param den1 The denominator of the first fraction (must be positive).
+             * @param num2 The numerator of the second fraction.
+             * @param den2 The denominator of the second fraction (must be positive).
+             * @return std::strong_ordering The ordering of the first fraction relative to the second.
+             * @note Used when the cross products don't fit in WideT (int128_t fractions), it never overflows.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            static constexpr std::strong_ordering _compare_ratios(UIntT num1, UIntT den1, UIntT num2, UIntT den2);
+
+            /*
+             * @brief Builds a fraction from a widened numerator and denominator.
+             * @param numerator The numerator of the fraction.
+             * @param denominator The denominator of the fraction (must be positive).
+             * @param overflowed True if an intermediate result overflowed (see _narrow_fraction()).
+             * @param approximation Returns the exact result as a long double.
+             * @param message The message of an intermediate overflow.
+             * @return BasicFraction The reduced fraction.
+             * @throw overflow_error if the reduced fraction doesn't fit in IntT (with the default policy).
+             * @note The fraction is reduced in WideT and only then narrowed, so big but reducible results don't overflow.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            template <typename Approximation>
+            static constexpr BasicFraction _from_wide(WideT numerator, WideT denominator, bool overflowed, Approximation approximation, const char* message);
+
+            /*
+             * @brief Adds or subtracts two fractions with Henrici's algorithm.
+             * @param num1 The numerator of the first fraction.
+             * @param den1 The denominator of the first fraction.
+             * @param num2 The numerator of the second fraction.
+             * @param den2 The denominator of the second fraction.
+             * @param sum Add or Subtract.
+             * @return BasicFraction The reduced sum (or difference).
+             * @throw overflow_error if the reduced sum doesn't fit in IntT (with the default policy).
+             * @note Both fractions must be reduced. Only the cofactors of g = gcd(den1, den2) are multiplied,
+             *       and the final reduction is by gcd(numerator, g) instead of a gcd of the full product.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            static constexpr BasicFraction _henrici_add(IntT num1, IntT den1, IntT num2, IntT den2, _Sum sum);
+
+            /*
+             * @brief A tag type that marks a numerator and denominator as already reduced.
+            */
+            struct _reduced_tag {};
+
+            /*
+             * @brief Checks if a numerator and a denominator are normalized (a positive denominator, coprime parts).
+             * @param numerator The numerator.
+             * @param denominator The denominator.
+             * @return True if the fraction is normalized, false otherwise.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            static constexpr bool _is_normalized(IntT numerator, IntT denominator) {
+                return denominator > 0 && _gcd(numerator, denominator) == 1;
+            }
+
+            /*
+             * @brief True if every fraction the trusted constructor gets must be normalized.
+             * @note Only the throwing policy guarantees it: the others may keep clamped or wrapped parts after an overflow.
+            */
+            static constexpr bool _asserts_normalized = std::is_same_v<Policy, overflow::ThrowOnOverflow>;
+
+            /*
+             * @brief Construct a new BasicFraction object from an already reduced numerator and denominator (the trusted constructor).
+             * @param numerator The numerator of the fraction.
+             * @param denominator The denominator of the fraction (must be positive).
+             * @note The zero and sign checks and the reduction are skipped, the caller guarantees the fraction is reduced.
+             *       Debug builds (without NDEBUG) assert it.
+            */
+            constexpr BasicFraction(IntT numerator, IntT denominator, _reduced_tag /*unused*/) noexcept: _numerator(numerator), _denominator(denominator) {
+                assert(!_asserts_normalized || _is_normalized(numerator, denominator));
+            }
+
+            /*
+             * @brief Every instantiation may use the reduced constructor of the others (the checked API rebinds the policy).
+            */
+            template <typename, typename>
+            friend class BasicFraction;
+
+            /*
+             * @brief The flat hash tables mark their empty slots with a 0 denominator, a fraction only they may build.
+            */
+            template <typename, typename, typename>
+            friend class detail::FlatHashTable;
+
+            /*
+             * @brief The accumulator builds its result from 128-bit parts like fma() does.
+            */
+            template <typename, typename>
+            friend class BasicFractionAccumulator;
+
+            /*
+             * @brief The lazy and the auto-promoting fractions and the fraction arrays hand over their reduced parts
+             *        through the trusted constructor.
+            */
+            template <typename>
+            friend class BasicLazyFraction;
+
+            friend class BigFraction;
+
+            friend class FractionArray;
+
+            /*
+             * @brief Builds a fraction from a 128-bit numerator and denominator (both parts of fma()).
+             * @param numerator The numerator of the fraction.
+             * @param denominator The denominator of the fraction (positive).
+             * @return BasicFraction The reduced fraction.
+             * @throw overflow_error if the reduced parts don't fit in IntT (with the default policy).
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            static constexpr BasicFraction _from_int128(int128_t numerator, int128_t denominator);
+
+            /*
+             * @brief Stores the result of an operation in the current fraction (the compound assignment operators).
+             * @param result The result.
+             * @return BasicFraction& The current fraction.
+            */
+            constexpr BasicFraction& _assign(const BasicFraction& result) noexcept {
+                _numerator = result._numerator;
+                _denominator = result._denominator;
+                return *this;
+            }
+
+            /*
+             * @brief The same fraction type with the FlagOnOverflow policy, which the checked API computes with.
+            */
+            using _Flagging = BasicFraction<IntT, overflow::FlagOnOverflow>;
+
+            /*
+             * @brief Runs an operation with the FlagOnOverflow policy and turns a raised flag into an error.
+             * @param operation The operation, returns a _Flagging fraction.
+             * @return Result<BasicFraction> The result of the operation, or FractionError::Overflow.
+             * @note The caller's sticky overflow flag is preserved.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            template <typename Operation>
+            static Result<BasicFraction> _checked(Operation operation) noexcept;
+
+            /*
+             * @brief Parses a decimal integer (leading whitespace and an optional sign) from the front of a string.
+             * @param text The string, the parsed characters are removed from it.
+             * @param num The parsed number (output).
+             * @return FractionError InvalidInput if there are no digits, Overflow if the number doesn't fit in IntT.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            static constexpr FractionError _parse_integer(std::string_view& text, IntT& num) noexcept;
+
+            /*
+             * @brief Decomposes a double into sign * mantissa * 2^exponent, with an odd mantissa (or 0).
+             * @param number The number.
+             * @param mantissa The mantissa (output, at most 53 bits).
+             * @param exponent The exponent (output).
+             * @param negative The sign (output).
+             * @return True if the number is finite, false for infinities and NaNs.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            static constexpr bool _decompose(double number, std::uint64_t& mantissa, int& exponent, bool& negative) noexcept;
+
+            /*
+             * @brief Gives a magnitude the requested sign.
+             * @param magnitude The magnitude (at most max_int, or max_int + 1 if negative).
+             * @param negative The sign.
+             * @return IntT The signed number.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            static constexpr IntT _with_sign(uint128_t magnitude, bool negative) noexcept {
+                return negative ? static_cast<IntT>(uint128_t{0} - magnitude) : static_cast<IntT>(magnitude);
+            }
+
+            /*
+             * @brief Finds the best rational approximation of rem_num / rem_den within the given bounds.
+             * @param rem_num The numerator of the value.
+             * @param rem_den The denominator of the value (positive).
+             * @param max_num The maximal numerator (the integer part of the value must not exceed it).
+             * @param max_den The maximal denominator (positive).
+             * @param negative The sign of the result.
+             * @return BasicFraction The best approximation (ties go to the smaller denominator).
+             * @note U is std::uint64_t when everything fits in it (the common case, cheaper divisions) and uint128_t otherwise.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            template <typename U>
+            static constexpr BasicFraction _best_approximation(U rem_num, U rem_den, U max_num, U max_den, bool negative);
+
+            /*
+             * @brief The scale of the floating point conversions: a float or a double x is treated as the fraction
+             *        round(1000 * x) / 1000.
+            */
+            static constexpr IntT _float_scale = 1000;
+
+            /*
+             * @brief Scales a float like the float constructor does (with the same rounding as a double).
+             * @param number The float.
+             * @return IntT The scaled numerator k of k / 1000.
+             * @throw overflow_error if k doesn't fit in IntT (or the number isn't finite).
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            static constexpr IntT _scale(float number) {
+                return _scale_rounded(static_cast<double>(number));
+            }
+
+            /*
+             * @brief Adds a fraction and a scaled float without building a temporary fraction.
+             * @param num The numerator of the fraction.
+             * @param den The denominator of the fraction.
+             * @param scaled The scaled float k.
+             * @param sum The operand order, e.g. Add for the reduced num / den + k / 1000 = (num * 1000 + k * den) / (den * 1000).
+             * @return BasicFraction The reduced sum.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            static constexpr BasicFraction _add_scaled(IntT num, IntT den, IntT scaled, _Sum sum) {
+                bool overflowed = false;
+                const WideT fraction = (sum == _Sum::Reverse) ? _negate(num, overflowed) : WideT{num};
+                const WideT term = (sum == _Sum::Subtract) ? _negate(scaled, overflowed) : WideT{scaled};
+                const WideT numerator = _add(_mul(fraction, _float_scale, overflowed), _mul(term, den, overflowed), overflowed);
+                const WideT denominator = _mul(den, _float_scale, overflowed);
+
+                return _from_wide(numerator, denominator, overflowed, [=] {
+                    return _approximate_sum(static_cast<long double>(num) / den, static_cast<long double>(scaled) / _float_scale, sum);
+                }, "Addition overflow");
+            }
+
+            /*
+             * @brief Builds a fraction from a quotient of two products, whose denominator may be negative.
+             * @param num1 The first factor of the numerator.
+             * @param num2 The second factor of the numerator.
+             * @param den1 The first factor of the denominator.
+             * @param den2 The second factor of the denominator (den1 * den2 is not 0).
+             * @param message The message of an intermediate overflow.
+             * @return BasicFraction The reduced (num1 * num2) / (den1 * den2).
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            static constexpr BasicFraction _from_quotient(WideT num1, WideT num2, WideT den1, WideT den2, const char* message) {
+                bool overflowed = false;
+                WideT numerator = _mul(num1, num2, overflowed), denominator = _mul(den1, den2, overflowed);
+
+                if (denominator < 0)
+                {
+                    numerator = _negate(numerator, overflowed);
+                    denominator = _negate(denominator, overflowed);
+                }
+
+                return _from_wide(numerator, denominator, overflowed, [=] {
+                    return static_cast<long double>(num1) * static_cast<long double>(num2) / (static_cast<long double>(den1) * static_cast<long double>(den2));
+                }, message);
+            }
+
+            /*
+             * @brief Scales a double to k / 1000, rounding to the nearest k (half away from zero).
+             * @param number The double.
+             * @return IntT The scaled numerator k of k / 1000.
+             * @throw overflow_error if k doesn't fit in IntT (or the number isn't finite).
+             * @note Rounding, not truncating, keeps values such as 2.3 (2299.9999... after scaling) exact, and 2.3f is 2.3 too.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            static constexpr IntT _scale_rounded(double number) {
+                const double scaled = 1000 * number;
+                const double bound = static_cast<double>(max_int) + 1.0;
+
+                if (!(scaled + 0.5 < bound && scaled - 0.5 > -bound))
+                    ARIEL_FRACTION_THROW(std::overflow_error("Fraction overflow"));
+
+                return static_cast<IntT>((scaled < 0) ? scaled - 0.5 : scaled + 0.5);
+            }
+
+            /*
+             * @brief Three-way compares the fraction and a double rounded like the double operators round it (to k / 1000).
+             * @param number The double.
+             * @return std::strong_ordering The ordering of the fraction relative to the double.
+             * @throw invalid_argument if the number is NaN.
+             * @note Doubles beyond the range of IntT (and the infinities) are ordered by their sign, nothing overflows.
+            */
+            constexpr std::strong_ordering _compare_double(double number) const {
+                if (number != number)
+                    ARIEL_FRACTION_THROW(std::invalid_argument("Number can't be NaN"));
+
+                const double magnitude = (number < 0) ? -number : number;
+
+                // Doubles from 2^53 on are integers, so the scaling doesn't change them.
+                if (magnitude >= 0x1p53)
+                {
+                    if (magnitude >= static_cast<double>(max_int))
+                        return (number < 0) ? std::strong_ordering::greater : std::strong_ordering::less;
+
+                    return *this <=> static_cast<IntT>(number);
+                }
+
+                // 1000 * 2^53 < 2^63, so k fits in every WideT.
+                const auto scaled_magnitude = static_cast<long long>(1000 * magnitude + 0.5);
+                const WideT scaled = (number < 0) ? -WideT{scaled_magnitude} : WideT{scaled_magnitude};
+
+                if constexpr (_is_widened)
+                {
+                    // a / b <=> k / 1000 is a * 1000 <=> k * b, and if k * b overflows, k alone decides.
+                    WideT product{};
+
+                    if (__builtin_mul_overflow(scaled, _denominator, &product))
+                        return (scaled < 0) ? std::strong_ordering::greater : std::strong_ordering::less;
+
+                    return static_cast<WideT>(_numerator) * _float_scale <=> product;
+                }
+
+                else
+                {
+                    if ((_numerator < 0) != (scaled < 0))
+                        return (_numerator < 0) ? std::strong_ordering::less : std::strong_ordering::greater;
+
+                    const std::strong_ordering ordering = _compare_ratios(_magnitude(_numerator), static_cast<UIntT>(_denominator), static_cast<UIntT>(scaled_magnitude), static_cast<UIntT>(_float_scale));
+                    return (_numerator < 0) ? 0 <=> ordering : ordering;
+                }
+            }
+
+            /*
+             * @brief Converts an integer operand of any type to WideT.
+             * @param num The integer.
+             * @param overflowed Set if the integer doesn't fit in WideT (the result wraps around).
+             * @return WideT The integer.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            template <typename Number>
+            static constexpr WideT _widen(Number num, bool& overflowed) {
+                constexpr WideT max_wide = std::numeric_limits<WideT>::max();
+                constexpr WideT min_wide = std::numeric_limits<WideT>::min();
+
+                if constexpr (std::numeric_limits<Number>::digits <= std::numeric_limits<WideT>::digits)
+                    return static_cast<WideT>(num);
+
+                else if constexpr (std::numeric_limits<Number>::is_signed)
+                    overflowed = num > static_cast<Number>(max_wide) || num < static_cast<Number>(min_wide) || overflowed;
+
+                else
+                    overflowed = num > static_cast<Number>(max_wide) || overflowed;
+
+                return static_cast<WideT>(num);
+            }
+
+            /*
+             * @brief Adds (or subtracts) an integer to a fraction, without a gcd.
+             * @param num The numerator of the fraction.
+             * @param den The denominator of the fraction.
+             * @param integer The integer n (of any integer type).
+             * @param sum The operand order, e.g. Add for (num + n * den) / den, which is already reduced.
+             * @return BasicFraction The sum.
+             * @note n may be as wide as WideT, so the operations are always overflow checked.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            template <typename Number>
+            static constexpr BasicFraction _add_integer(IntT num, IntT den, Number integer, _Sum sum) {
+                bool overflowed = false;
+                const WideT wide = _widen(integer, overflowed);
+                WideT product{}, result{};
+                overflowed = __builtin_mul_overflow(wide, den, &product) || overflowed;
+
+                if (sum == _Sum::Add)
+                    overflowed = __builtin_add_overflow(WideT{num}, product, &result) || overflowed;
+
+                else if (sum == _Sum::Subtract)
+                    overflowed = __builtin_sub_overflow(WideT{num}, product, &result) || overflowed;
+
+                else
+                    overflowed = __builtin_sub_overflow(product, WideT{num}, &result) || overflowed;
+
+                return _narrow_fraction(result, WideT{den}, overflowed, [=] {
+                    return _approximate_sum(static_cast<long double>(num) / den, static_cast<long double>(integer), sum);
+                }, "Addition overflow");
+            }
+
+            /*
+             * @brief Multiplies a fraction by an integer.
+             * @param num The numerator of the fraction.
+             * @param den The denominator of the fraction.
+             * @param integer The integer n (of any integer type).
+             * @return BasicFraction (num * (n / g)) / (den / g) with g = gcd(n, den), which is already reduced.
              * @note This function is static because it is only used internally and doesn't require an instance of the class.
             */
-            static int _overflow_division_check(int num1, int num2) {
-                if (num2 == 0 || (num1 == min_int && num2 == -1))
+            template <typename Number>
+            static constexpr BasicFraction _mul_integer(IntT num, IntT den, Number integer) {
+                bool overflowed = false;
+                const WideT wide = _widen(integer, overflowed);
+                const auto gcd_fact = static_cast<WideT>(_gcd_wide(_magnitude(wide), static_cast<UWideT>(den)));
+                WideT product{};
+                overflowed = __builtin_mul_overflow(static_cast<WideT>(num), wide / gcd_fact, &product) || overflowed;
+
+                return _narrow_fraction(product, static_cast<WideT>(den / gcd_fact), overflowed, [=] {
+                    return static_cast<long double>(num) / den * static_cast<long double>(integer);
+                }, "Multiplication overflow");
+            }
+
+            /*
+             * @brief Divides a fraction by an integer.
+             * @param num The numerator of the fraction.
+             * @param den The denominator of the fraction.
+             * @param integer The integer n (of any integer type, not 0).
+             * @return BasicFraction (num / g) / (den * (n / g)) with g = gcd(num, n), which is already reduced.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            template <typename Number>
+            static constexpr BasicFraction _div_integer(IntT num, IntT den, Number integer) {
+                if (num == 0)
+                    return BasicFraction();
+
+                bool overflowed = false;
+                const WideT wide = _widen(integer, overflowed);
+                const auto gcd_fact = static_cast<WideT>(_gcd_wide(_magnitude(static_cast<WideT>(num)), _magnitude(wide)));
+                WideT numerator = num / gcd_fact, denominator{};
+                overflowed = __builtin_mul_overflow(static_cast<WideT>(den), wide / gcd_fact, &denominator) || overflowed;
+
+                if (denominator < 0)
                 {
-                    throw std::overflow_error("Division overflow");
+                    numerator = _negate(numerator, overflowed);
+                    denominator = _negate(denominator, overflowed);
                 }
 
-                return (num1 / num2);
+                return _narrow_fraction(numerator, denominator, overflowed, [=] {
+                    return static_cast<long double>(num) / den / static_cast<long double>(integer);
+                }, "Division overflow");
+            }
+
+            /*
+             * @brief Divides an integer by a fraction.
+             * @param integer The integer n (of any integer type).
+             * @param num The numerator of the fraction (not 0).
+             * @param den The denominator of the fraction.
+             * @return BasicFraction ((n / g) * den) / (num / g) with g = gcd(n, num), which is already reduced.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            template <typename Number>
+            static constexpr BasicFraction _integer_div(Number integer, IntT num, IntT den) {
+                bool overflowed = false;
+                const WideT wide = _widen(integer, overflowed);
+                const auto gcd_fact = static_cast<WideT>(_gcd_wide(_magnitude(wide), _magnitude(static_cast<WideT>(num))));
+                WideT numerator{}, denominator = num / gcd_fact;
+                overflowed = __builtin_mul_overflow(wide / gcd_fact, static_cast<WideT>(den), &numerator) || overflowed;
+
+                if (denominator < 0)
+                {
+                    denominator = _negate(denominator, overflowed);
+                    numerator = _negate(numerator, overflowed);
+                }
+
+                return _narrow_fraction(numerator, denominator, overflowed, [=] {
+                    return static_cast<long double>(integer) * den / num;
+                }, "Division overflow");
+            }
+
+            /*
+             * @brief Checks if a numerator and a denominator are exactly representable as doubles (at most 2^53).
+             * @param numerator The numerator.
+             * @param denominator The denominator (positive).
+             * @return True if a single double division gives the correctly rounded quotient, false otherwise.
+             * @note Always true for fractions of 53 bits or less (e.g. int).
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            static constexpr bool _fits_double(IntT numerator, IntT denominator) noexcept {
+                constexpr int exact_bits = std::numeric_limits<double>::digits;
+
+                if constexpr (std::numeric_limits<IntT>::digits <= exact_bits)
+                    return true;
+
+                else
+                    return _magnitude(numerator) <= (UIntT{1} << exact_bits) && static_cast<UIntT>(denominator) <= (UIntT{1} << exact_bits);
             }
 
+            /*
+             * @brief Calculates 2^exponent as a double.
+             * @param exponent The exponent (of a normal double, -1022 to 1023).
+             * @return double The exact power of 2.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            static constexpr double _power_of_two(int exponent) noexcept {
+                constexpr int mantissa_bits = std::numeric_limits<double>::digits - 1;
+                constexpr int exponent_bias = std::numeric_limits<double>::max_exponent - 1;
+
+                return std::bit_cast<double>(static_cast<std::uint64_t>(exponent + exponent_bias) << mantissa_bits);
+            }
+
+            /*
+             * @brief Converts the fraction to the nearest FloatT (float or double), ties to even.
+             * @return FloatT The correctly rounded value.
+             * @note If both parts fit in 53 bits, one double division is correctly rounded (IEEE-754 rounds the exact
+             *       quotient), and rounding that to float is too: the double rounding is harmless since 53 >= 2 * 24 + 2.
+             * @note Otherwise the quotient bits, a rounding bit and a sticky remainder come from exact binary long division.
+            */
+            template <typename FloatT>
+            constexpr FloatT _to_floating() const;
+
+            /*
+             * @brief Converts many fractions to FloatT (float or double).
+             * @param fractions The fractions.
+             * @param results The correctly rounded values (output).
+             * @throw invalid_argument if results is shorter than fractions.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            template <typename FloatT>
+            static constexpr void _to_floating(std::span<const BasicFraction> fractions, std::span<FloatT> results);
+
         public:
             /*********************/
             /* Constructors zone */
@@ -164,42 +958,187 @@ namespace ariel
              * @brief Default constructor of the Fraction class.
              * @note The default fraction is 0/1 (zero).
             */
-            Fraction();
+            constexpr BasicFraction();
 
             /*
              * @brief Convert constructor from float to Fraction.
              * @param number The number to convert to a fraction.
-             * @note This constructor is used to convert a float to a fraction.
+             * @throw overflow_error if round(1000 * number) doesn't fit in IntT (or the number isn't finite).
+             * @note This constructor is used to convert a float to a fraction, rounded to k / 1000 like the float operators.
+            */
+            constexpr BasicFraction(float number);
+
+            /*
+             * @brief Convert constructor from double (or long double) to Fraction.
+             * @param number The number to convert to a fraction.
+             * @throw overflow_error if round(1000 * number) doesn't fit in IntT (or the number isn't finite).
+             * @note Rounded to k / 1000 like the double operators, so Fraction(x) == x. Without it, a double would be
+             *       narrowed to a float first.
             */
-            Fraction(float number);
+            template <typename Number> requires (std::is_floating_point_v<Number> && !std::is_same_v<Number, float>)
+            constexpr BasicFraction(Number number);
 
             /*
              * @brief Construct a new Fraction object
              * @param numerator The numerator of the fraction.
              * @param denominator The denominator of the fraction.
              * @throw invalid_argument if the denominator is 0.
+             * @throw overflow_error if the reduced fraction doesn't fit in IntT (e.g. 3 / min_int or min_int / -1),
+             *        with the default policy (the others resolve it like the arithmetic operators do).
              * @note The fraction will be reduced to its simplest form.
             */
-            Fraction(int numerator, int denominator);
+            constexpr BasicFraction(IntT numerator, IntT denominator);
 
             /*
              * @brief Copy constructor of the Fraction class.
              * @param other The fraction to copy.
+             * @note Defaulted, so the fraction is trivially copyable (see the static_asserts below the class).
             */
-            Fraction(const Fraction& other);
+            constexpr BasicFraction(const BasicFraction& other) = default;
 
             /*
              * @brief Move constructor of the Fraction class.
              * @param other The fraction to move.
              * @note This constructor is used to move the fraction to another fraction.
+             * @note Defaulted, moving is copying the two parts.
             */
-            Fraction(Fraction&& other) noexcept;
+            constexpr BasicFraction(BasicFraction&& other) noexcept = default;
 
             /*
              * @brief A destructor of the Fraction class.
              * @note This destructor is default because it doesn't do anything.
             */
-            ~Fraction() = default;
+            ~BasicFraction() = default;
+
+
+            /**************************************************************/
+            /* Checked operations zone - never throw, for hot error paths */
+            /* and -fno-exceptions builds                                 */
+            /**************************************************************/
+
+            /*
+             * @brief Constructs a fraction without throwing.
+             * @param numerator The numerator of the fraction.
+             * @param denominator The denominator of the fraction.
+             * @return Result<BasicFraction> The reduced fraction, FractionError::ZeroDenominator,
+             *         or FractionError::Overflow if the reduced fraction's sign can't be normalized (e.g. INT_MIN/-1).
+            */
+            static constexpr Result<BasicFraction> checked_make(IntT numerator, IntT denominator) noexcept;
+
+            /*
+             * @brief Parses a fraction ("numerator/denominator" or "numerator denominator") without throwing.
+             * @param text The text to parse, surrounding whitespace is allowed.
+             * @return Result<BasicFraction> The reduced fraction, or FractionError::InvalidInput, ZeroDenominator or Overflow.
+            */
+            static constexpr Result<BasicFraction> checked_parse(std::string_view text) noexcept;
+
+            /*
+             * @brief Adds two fractions without throwing.
+             * @return Result<BasicFraction> The sum, or FractionError::Overflow.
+            */
+            static Result<BasicFraction> checked_add(const BasicFraction& num1, const BasicFraction& num2) noexcept;
+
+            /*
+             * @brief Subtracts two fractions without throwing.
+             * @return Result<BasicFraction> The difference, or FractionError::Overflow.
+            */
+            static Result<BasicFraction> checked_sub(const BasicFraction& num1, const BasicFraction& num2) noexcept;
+
+            /*
+             * @brief Multiplies two fractions without throwing.
+             * @return Result<BasicFraction> The product, or FractionError::Overflow.
+            */
+            static Result<BasicFraction> checked_mul(const BasicFraction& num1, const BasicFraction& num2) noexcept;
+
+            /*
+             * @brief Divides two fractions without throwing.
+             * @return Result<BasicFraction> The quotient, or FractionError::DivisionByZero or Overflow.
+            */
+            static Result<BasicFraction> checked_div(const BasicFraction& num1, const BasicFraction& num2) noexcept;
+
+
+            /**********************************************/
+            /* Fused operations zone - a single reduction */
+            /**********************************************/
+
+            /*
+             * @brief Calculates num1 * num2 + num3 with a single reduction.
+             * @param num1 The first factor.
+             * @param num2 The second factor.
+             * @param num3 The addend.
+             * @return BasicFraction The reduced num1 * num2 + num3.
+             * @throw overflow_error if the result doesn't fit (with the default policy).
+             * @note The unreduced (n1 * n2 * d3 + n3 * d1 * d2) / (d1 * d2 * d3) is computed in 128 bits (always enough
+             *       for int fractions) and reduced once, instead of the two reductions and overflow checks of each operator.
+             *       If it doesn't fit in 128 bits (wider fractions), the regular operators are used.
+             * @see BasicFractionAccumulator (FractionAccumulator.hpp) for sums of many products.
+            */
+            static constexpr BasicFraction fma(const BasicFraction& num1, const BasicFraction& num2, const BasicFraction& num3);
+
+
+            /*****************************************/
+            /* Conversions zone - from double values */
+            /*****************************************/
+
+            /*
+             * @brief Converts a double to the exactly equal fraction.
+             * @param number The number to convert.
+             * @return BasicFraction The fraction, its denominator is a power of 2.
+             * @throw invalid_argument if the number isn't finite.
+             * @throw overflow_error if the exact value doesn't fit (e.g. 0.1 needs a 2^55 denominator).
+             * @note The mantissa and the exponent are taken from the IEEE-754 bits: no division, no gcd
+             *       (an odd mantissa over a power of 2 is already reduced).
+            */
+            static constexpr BasicFraction from_double_exact(double number);
+
+            /*
+             * @brief Converts a double to the closest fraction whose denominator is at most max_denominator.
+             * @param number The number to convert.
+             * @param max_denominator The maximal denominator (positive).
+             * @return BasicFraction The best rational approximation (ties go to the smaller denominator).
+             * @throw invalid_argument if the number isn't finite or max_denominator isn't positive.
+             * @throw overflow_error if the integer part of the number doesn't fit in IntT.
+             * @note Walks the continued fraction (Stern-Brocot) expansion of the exact value of the double, and picks
+             *       between the last fitting convergent and the best semiconvergent, so no floating-point error creeps in.
+            */
+            static constexpr BasicFraction from_double_rounded(double number, IntT max_denominator = max_int);
+
+
+            /***********************************************/
+            /* Conversions zone - to floating point values */
+            /***********************************************/
+
+            /*
+             * @brief Converts the fraction to the nearest double (ties to even).
+             * @return double The correctly rounded value.
+             * @note Parts of up to 53 bits (always, for int fractions) take a single double division,
+             *       wider ones are divided exactly, bit by bit.
+            */
+            constexpr double to_double() const;
+
+            /*
+             * @brief Converts the fraction to the nearest float (ties to even).
+             * @return float The correctly rounded value.
+            */
+            constexpr float to_float() const;
+
+            /*
+             * @brief Converts many fractions to doubles.
+             * @param fractions The fractions.
+             * @param results The correctly rounded values (output, at least as long as fractions).
+             * @throw invalid_argument if results is shorter than fractions.
+             * @note The main loop is branch free (conversions and a division per element), so the compiler vectorizes it.
+             *       For fractions wider than 53 bits, a second pass redoes the few values that didn't fit exactly.
+            */
+            static constexpr void to_double(std::span<const BasicFraction> fractions, std::span<double> results);
+
+            /*
+             * @brief Converts many fractions to floats.
+             * @param fractions The fractions.
+             * @param results The correctly rounded values (output, at least as long as fractions).
+             * @throw invalid_argument if results is shorter than fractions.
+            */
+            static constexpr void to_float(std::span<const BasicFraction> fractions, std::span<float> results);
 
 
             /************************************************************************/
@@ -208,15 +1147,15 @@ namespace ariel
 
             /*
              * @brief Gets the numerator of the fraction.
-             * @return int The numerator of the fraction.
+             * @return IntT The numerator of the fraction.
             */
-            int getNumerator() const;
+            constexpr IntT getNumerator() const;
 
             /*
              * @brief Gets the denominator of the fraction.
-             * @return int The denominator of the fraction.
+             * @return IntT The denominator of the fraction.
             */
-            int getDenominator() const;
+            constexpr IntT getDenominator() const;
 
 
             /**************************************************/
@@ -226,17 +1165,19 @@ namespace ariel
             /*
              * @brief Assigns a fraction to another fraction.
              * @param other The fraction to assign.
-             * @return Fraction& The assigned fraction.
+             * @return BasicFraction& The assigned fraction.
+             * @note Defaulted, a self assignment needs no check (it copies the same two parts).
             */
-            Fraction& operator=(const Fraction& other);
+            constexpr BasicFraction& operator=(const BasicFraction& other) = default;
 
             /*
              * @brief Assigns a fraction to another fraction.
              * @param other The fraction to assign.
-             * @return Fraction& The assigned fraction.
+             * @return BasicFraction& The assigned fraction.
              * @note This function is used to move the fraction to another fraction.
+             * @note Defaulted, moving is copying the two parts.
             */
-            Fraction& operator=(Fraction&& other) noexcept;
+            constexpr BasicFraction& operator=(BasicFraction&& other) noexcept = default;
 
 
             /**********************************************/
@@ -249,7 +1190,7 @@ namespace ariel
              * @param fraction The fraction to print.
              * @return The output stream.
             */
-            friend std::ostream& operator<<(std::ostream& outstream, const Fraction& fraction);
+            friend std::ostream& operator<< <>(std::ostream& outstream, const BasicFraction& fraction);
 
             /*
              * @brief Reads the fraction from the input stream.
@@ -257,7 +1198,7 @@ namespace ariel
              * @param fraction The fraction to read.
              * @return The input stream.
             */
-            friend std::istream& operator>>(std::istream& inptstream, Fraction& fraction);
+            friend std::istream& operator>> <>(std::istream& inptstream, BasicFraction& fraction);
 
 
             /**************************************************/
@@ -269,14 +1210,14 @@ namespace ariel
              * @param other The fraction to add.
              * @return The result of the addition.
             */
-            const Fraction operator+(const Fraction& other) const;
+            constexpr const BasicFraction operator+(const BasicFraction& other) const;
 
             /*
              * @brief Adds a fraction to a float.
              * @param num The float to add.
              * @return  The result of the addition.
             */
-            const Fraction operator+(const float& num) const;
+            constexpr const BasicFraction operator+(const float& num) const;
 
             /*
              * @brief Adds a fraction to a float.
@@ -284,21 +1225,23 @@ namespace ariel
              * @param other The fraction to add.
              * @return The result of the addition.
             */
-            friend const Fraction operator+(const float& num, const Fraction& other);
+            friend constexpr const BasicFraction operator+(const float& num, const BasicFraction& other) {
+                return other + num;
+            }
 
             /*
              * @brief Subtracts two fractions.
              * @param other The fraction to subtract.
              * @return The result of the subtraction.
             */
-            const Fraction operator-(const Fraction& other) const;
+            constexpr const BasicFraction operator-(const BasicFraction& other) const;
 
             /*
              * @brief Subtracts a fraction from a float.
              * @param num The float to subtract.
              * @return The result of the subtraction.
             */
-            const Fraction operator-(const float& num) const;
+            constexpr const BasicFraction operator-(const float& num) const;
 
             /*
              * @brief Subtracts a fraction from a float.
@@ -306,21 +1249,23 @@ namespace ariel
              * @param other The fraction to subtract.
              * @return The result of the subtraction.
             */
-            friend const Fraction operator-(const float& num, const Fraction& other);
+            friend constexpr const BasicFraction operator-(const float& num, const BasicFraction& other) {
+                return _add_scaled(other._numerator, other._denominator, _scale(num), _Sum::Reverse);
+            }
 
             /*
              * @brief Multiplies two fractions.
              * @param other The fraction to multiply.
              * @return The result of the multiplication.
             */
-            const Fraction operator*(const Fraction& other) const;
+            constexpr const BasicFraction operator*(const BasicFraction& other) const;
 
             /*
              * @brief Multiplies a fraction by a float.
              * @param num The float to multiply.
              * @return The result of the multiplication.
             */
-            const Fraction operator*(const float& num) const;
+            constexpr const BasicFraction operator*(const float& num) const;
 
             /*
              * @brief Multiplies a fraction by a float.
@@ -328,21 +1273,23 @@ namespace ariel
              * @param other The fraction to multiply.
              * @return The result of the multiplication.
             */
-            friend const Fraction operator*(const float& num, const Fraction& other);
+            friend constexpr const BasicFraction operator*(const float& num, const BasicFraction& other) {
+                return other * num;
+            }
 
             /*
              * @brief Divides two fractions.
              * @param other The fraction to divide.
              * @return The result of the division.
             */
-            const Fraction operator/(const Fraction& other) const;
+            constexpr const BasicFraction operator/(const BasicFraction& other) const;
 
             /*
              * @brief Divides a fraction by a float.
              * @param num The float to divide.
              * @return The result of the division.
             */
-            const Fraction operator/(const float& num) const;
+            constexpr const BasicFraction operator/(const float& num) const;
 
             /*
              * @brief Divides a fraction by a float.
@@ -350,31 +1297,41 @@ namespace ariel
              * @param other The fraction to divide.
              * @return The result of the division.
             */
-            friend const Fraction operator/(const float& num, const Fraction& other);
+            friend constexpr const BasicFraction operator/(const float& num, const BasicFraction& other) {
+                if (other._numerator == 0)
+                    ARIEL_FRACTION_THROW(std::runtime_error("Can't divide by zero"));
+
+                // (k / 1000) / (a / b) = (k * b) / (1000 * a)
+                return _from_quotient(_scale(num), other._denominator, _float_scale, other._numerator, "Division overflow");
+            }
 
             /*
              * @brief Increments the current fraction by 1 (pre-increment).
              * @return The current fraction.
+             * @throw overflow_error if the result doesn't fit (with the default policy).
+             * @note No gcd: the result is built with the trusted constructor.
             */
-            Fraction& operator++();
+            constexpr BasicFraction& operator++();
 
             /*
              * @brief Decrements the current fraction by 1 (pre-decrement).
              * @return The current fraction.
+             * @throw overflow_error if the result doesn't fit (with the default policy).
+             * @note No gcd: the result is built with the trusted constructor.
             */
-            Fraction& operator--();
+            constexpr BasicFraction& operator--();
 
             /*
              * @brief Increments the current fraction by 1 (post-increment).
              * @return The current fraction.
             */
-            Fraction operator++(int);
+            constexpr BasicFraction operator++(int);
 
             /*
              * @brief Decrements the current fraction by 1 (post-decrement).
              * @return The current fraction.
             */
-            Fraction operator--(int);
+            constexpr BasicFraction operator--(int);
 
 
             /**************************************************/
@@ -385,133 +1342,1152 @@ namespace ariel
              * @brief Compares two fractions.
              * @param other The fraction to compare.
              * @return True if the fractions are equal, false otherwise.
+             * @note The != operator is synthesized from this operator.
             */
-            bool operator==(const Fraction& other) const;
+            constexpr bool operator==(const BasicFraction& other) const;
 
             /*
              * @brief Compares a fraction and an float.
              * @param other The float to compare.
              * @return True if the fractions are equal, false otherwise.
+             * @note The != operator and the reversed (float == Fraction) forms are synthesized from this operator.
             */
-            bool operator==(const float& other) const;
+            constexpr bool operator==(const float& other) const;
 
             /*
-             * @brief Compares a fraction and an float.
+             * @brief Three-way compares two fractions.
+             * @param other The fraction to compare.
+             * @return std::strong_ordering The ordering of the current fraction relative to the other fraction.
+             * @note The <, >, <= and >= operators are synthesized from this operator, so the ordering is computed once.
+             * @note The cross products are computed in WideT (or with a continued fraction expansion for int128_t),
+             *       so they can't overflow.
+            */
+            constexpr std::strong_ordering operator<=>(const BasicFraction& other) const;
+
+            /*
+             * @brief Three-way compares a fraction and a float.
              * @param other The float to compare.
-             * @param num The fraction to compare.
-             * @return True if the fractions are equal, false otherwise.
+             * @return std::strong_ordering The ordering of the current fraction relative to the float.
+             * @note The <, >, <= and >= operators and the reversed (float < Fraction) forms are synthesized from this operator.
             */
-            friend bool operator==(const float& num, const Fraction& other);
+            constexpr std::strong_ordering operator<=>(const float& other) const;
+
+
+            /*********************************************************************/
+            /* Operators overload zone - Mixed operators with integers (without */
+            /* a gcd for + and -) and doubles (rounded to k / 1000)              */
+            /*********************************************************************/
 
             /*
-             * @brief Compares two fractions.
-             * @param other The fraction to compare.
-             * @return True if the fractions are not equal, false otherwise.
+             * @brief Adds a fraction and an integer or a double.
+             * @param num The number to add.
+             * @return The result of the addition.
             */
-            bool operator!=(const Fraction& other) const;
+            template <typename Number> requires detail::fraction_scalar<Number>
+            constexpr const BasicFraction operator+(const Number& num) const;
 
             /*
-             * @brief Compares a fraction and an float.
-             * @param other The float to compare.
-             * @return True if the fractions are not equal, false otherwise.
+             * @brief Adds an integer or a double and a fraction.
             */
-            bool operator!=(const float& other) const;
+            template <typename Number> requires detail::fraction_scalar<Number>
+            friend constexpr const BasicFraction operator+(const Number& num, const BasicFraction& other) {
+                return other + num;
+            }
 
             /*
-             * @brief Compares a fraction and an float.
-             * @param other The float to compare.
-             * @param num The fraction to compare.
-             * @return True if the fractions are not equal, false otherwise.
+             * @brief Subtracts an integer or a double from a fraction.
+             * @param num The number to subtract.
+             * @return The result of the subtraction.
             */
-            friend bool operator!=(const float& num, const Fraction& other);
+            template <typename Number> requires detail::fraction_scalar<Number>
+            constexpr const BasicFraction operator-(const Number& num) const;
 
             /*
-             * @brief Compares two fractions.
-             * @param other The fraction to compare.
-             * @return True if the current fraction is greater than the other fraction, false otherwise.
+             * @brief Subtracts a fraction from an integer or a double.
             */
-            bool operator>(const Fraction& other) const;
+            template <typename Number> requires detail::fraction_scalar<Number>
+            friend constexpr const BasicFraction operator-(const Number& num, const BasicFraction& other) {
+                if constexpr (std::numeric_limits<Number>::is_integer)
+                    return _add_integer(other._numerator, other._denominator, num, _Sum::Reverse);
+
+                else
+                    return _add_scaled(other._numerator, other._denominator, _scale_rounded(static_cast<double>(num)), _Sum::Reverse);
+            }
 
             /*
-             * @brief Compares a fraction and a float.
-             * @param other The float to compare.
-             * @return True if the current fraction is greater than the float, false otherwise.
+             * @brief Multiplies a fraction by an integer or a double.
+             * @param num The number to multiply by.
+             * @return The result of the multiplication.
             */
-            bool operator>(const float& other) const;
+            template <typename Number> requires detail::fraction_scalar<Number>
+            constexpr const BasicFraction operator*(const Number& num) const;
 
             /*
-             * @brief Compares a fraction and a float.
-             * @param other The float to compare.
-             * @param num The fraction to compare.
-             * @return True if the current fraction is greater than the float, false otherwise.
+             * @brief Multiplies an integer or a double by a fraction.
             */
-            friend bool operator>(const float& num, const Fraction& other);
+            template <typename Number> requires detail::fraction_scalar<Number>
+            friend constexpr const BasicFraction operator*(const Number& num, const BasicFraction& other) {
+                return other * num;
+            }
 
-            /* 
-             * @brief Compares two fractions.
-             * @param other The fraction to compare.
-             * @return True if the current fraction is less than the other fraction, false otherwise.
+            /*
+             * @brief Divides a fraction by an integer or a double.
+             * @param num The number to divide by.
+             * @return The result of the division.
+             * @throw runtime_error if the number is 0 (or a double that rounds to 0 / 1000).
             */
-            bool operator<(const Fraction& other) const;
+            template <typename Number> requires detail::fraction_scalar<Number>
+            constexpr const BasicFraction operator/(const Number& num) const;
 
             /*
-             * @brief Compares a fraction and a float.
-             * @param other The float to compare.
-             * @return True if the current fraction is less than the float, false otherwise.
+             * @brief Divides an integer or a double by a fraction.
+             * @throw runtime_error if the fraction is 0.
             */
-            bool operator<(const float& other) const;
+            template <typename Number> requires detail::fraction_scalar<Number>
+            friend constexpr const BasicFraction operator/(const Number& num, const BasicFraction& other) {
+                if (other._numerator == 0)
+                    ARIEL_FRACTION_THROW(std::runtime_error("Can't divide by zero"));
+
+                // n / (a / b) = (n * b) / a
+                if constexpr (std::numeric_limits<Number>::is_integer)
+                    return _integer_div(num, other._numerator, other._denominator);
+
+                else
+                    return _from_quotient(_scale_rounded(static_cast<double>(num)), other._denominator, _float_scale, other._numerator, "Division overflow");
+            }
 
             /*
-             * @brief Compares a fraction and a float.
-             * @param other The float to compare.
-             * @param num The fraction to compare.
-             * @return True if the current fraction is less than the float, false otherwise.
+             * @brief Compares a fraction and an integer or a double.
+             * @note Nothing overflows: integers and doubles beyond the range of the fraction are ordered by their sign.
+             * @note The != operator and the reversed forms are synthesized from this operator.
             */
-            friend bool operator<(const float& num, const Fraction& other);
+            template <typename Number> requires detail::fraction_scalar<Number>
+            constexpr bool operator==(const Number& num) const;
 
             /*
-             * @brief Compares two fractions.
-             * @param other The fraction to compare.
-             * @return True if the current fraction is greater than or equal to the other fraction, false otherwise.
+             * @brief Three-way compares a fraction and an integer or a double.
+             * @note Nothing overflows: integers and doubles beyond the range of the fraction are ordered by their sign.
+             * @note The <, >, <= and >= operators and the reversed forms are synthesized from this operator.
             */
-            bool operator>=(const Fraction& other) const;
+            template <typename Number> requires detail::fraction_scalar<Number>
+            constexpr std::strong_ordering operator<=>(const Number& num) const;
+
+
+            /***********************************************************/
+            /* Operators overload zone - Compound assignment operators */
+            /***********************************************************/
 
             /*
-             * @brief Compares a fraction and a float.
-             * @param other The float to compare.
-             * @return True if the current fraction is greater than or equal to the float, false otherwise.
+             * @brief Adds a fraction to the current fraction.
+             * @param other The fraction.
+             * @return BasicFraction& The current fraction.
+             * @note The sum is computed by the kernel of operator+ and then stored in the current fraction, so x += x works.
             */
-            bool operator>=(const float& other) const;
+            constexpr BasicFraction& operator+=(const BasicFraction& other);
 
             /*
-             * @brief Compares a fraction and a float.
-             * @param other The float to compare.
-             * @param num The fraction to compare.
-             * @return True if the current fraction is greater than or equal to the float, false otherwise.
+             * @brief Adds a float to the current fraction.
+             * @param num The float.
+             * @return BasicFraction& The current fraction.
             */
-            friend bool operator>=(const float& num, const Fraction& other);
+            constexpr BasicFraction& operator+=(const float& num);
 
             /*
-             * @brief Compares two fractions.
-             * @param other The fraction to compare.
-             * @return True if the current fraction is less than or equal to the other fraction, false otherwise.
+             * @brief Adds an integer or a double to the current fraction.
+             * @param num The integer or the double.
+             * @return BasicFraction& The current fraction.
             */
-            bool operator<=(const Fraction& other) const;
+            template <typename Number> requires detail::fraction_scalar<Number>
+            constexpr BasicFraction& operator+=(const Number& num);
 
             /*
-             * @brief Compares a fraction and a float.
-             * @param other The float to compare.
-             * @return True if the current fraction is less than or equal to the float, false otherwise.
+             * @brief Subtracts a fraction from the current fraction.
+             * @param other The fraction.
+             * @return BasicFraction& The current fraction.
+             * @note The difference is computed by the kernel of operator- and then stored in the current fraction, so x -= x works.
             */
-            bool operator<=(const float& other) const;
+            constexpr BasicFraction& operator-=(const BasicFraction& other);
 
             /*
-             * @brief Compares a fraction and a float.
-             * @param other The float to compare.
-             * @param num The fraction to compare.
-             * @return True if the current fraction is less than or equal to the float, false otherwise.
+             * @brief Subtracts a float from the current fraction.
+             * @param num The float.
+             * @return BasicFraction& The current fraction.
+            */
+            constexpr BasicFraction& operator-=(const float& num);
+
+            /*
+             * @brief Subtracts an integer or a double from the current fraction.
+             * @param num The integer or the double.
+             * @return BasicFraction& The current fraction.
+            */
+            template <typename Number> requires detail::fraction_scalar<Number>
+            constexpr BasicFraction& operator-=(const Number& num);
+
+            /*
+             * @brief Multiplies the current fraction by a fraction.
+             * @param other The fraction.
+             * @return BasicFraction& The current fraction.
+             * @note The product is computed by the kernel of operator* and then stored in the current fraction, so x *= x works.
+            */
+            constexpr BasicFraction& operator*=(const BasicFraction& other);
+
+            /*
+             * @brief Multiplies the current fraction by a float.
+             * @param num The float.
+             * @return BasicFraction& The current fraction.
+            */
+            constexpr BasicFraction& operator*=(const float& num);
+
+            /*
+             * @brief Multiplies the current fraction by an integer or a double.
+             * @param num The integer or the double.
+             * @return BasicFraction& The current fraction.
             */
-            friend bool operator<=(const float& num, const Fraction& other);
+            template <typename Number> requires detail::fraction_scalar<Number>
+            constexpr BasicFraction& operator*=(const Number& num);
+
+            /*
+             * @brief Divides the current fraction by a fraction.
+             * @param other The fraction.
+             * @return BasicFraction& The current fraction.
+             * @throw runtime_error if the divisor is zero.
+             * @note The quotient is computed by the kernel of operator/ and then stored in the current fraction, so x /= x works.
+            */
+            constexpr BasicFraction& operator/=(const BasicFraction& other);
+
+            /*
+             * @brief Divides the current fraction by a float.
+             * @param num The float.
+             * @return BasicFraction& The current fraction.
+             * @throw runtime_error if the divisor is zero.
+            */
+            constexpr BasicFraction& operator/=(const float& num);
+
+            /*
+             * @brief Divides the current fraction by an integer or a double.
+             * @param num The integer or the double.
+             * @return BasicFraction& The current fraction.
+             * @throw runtime_error if the divisor is zero.
+            */
+            template <typename Number> requires detail::fraction_scalar<Number>
+            constexpr BasicFraction& operator/=(const Number& num);
     };
 
-}
\ No newline at end of file
+    /*
+     * @brief A fraction of two ints (the original Fraction class).
+    */
+    using Fraction = BasicFraction<int>;
+
+    /*
+     * @brief A fraction of two 64-bit integers.
+    */
+    using Fraction64 = BasicFraction<std::int64_t>;
+
+    /*
+     * @brief A fraction of two 128-bit integers.
+    */
+    using Fraction128 = BasicFraction<int128_t>;
+
+    /*
+     * @brief Fractions of two ints with the other overflow policies.
+    */
+    using SaturatingFraction = BasicFraction<int, overflow::SaturateOnOverflow>;
+    using FlaggingFraction = BasicFraction<int, overflow::FlagOnOverflow>;
+    using UncheckedFraction = BasicFraction<int, overflow::UncheckedOverflow>;
+
+    /*
+     * @brief A fraction is just its two parts: containers and algorithms may copy and relocate it with memcpy/memmove.
+    */
+    static_assert(std::is_trivially_copyable_v<Fraction> && std::is_trivially_copyable_v<Fraction64> && std::is_trivially_copyable_v<Fraction128>);
+    static_assert(std::is_trivially_copyable_v<SaturatingFraction> && std::is_trivially_copyable_v<FlaggingFraction> && std::is_trivially_copyable_v<UncheckedFraction>);
+    static_assert(std::is_standard_layout_v<Fraction> && std::is_standard_layout_v<Fraction64> && std::is_standard_layout_v<Fraction128>);
+    static_assert(sizeof(Fraction) == 2 * sizeof(int) && alignof(Fraction) == alignof(int));
+
+
+    /********************************************************************/
+    /* Inline definitions - everything but the stream operators is      */
+    /* constexpr and lives here, so it can be inlined and folded by any */
+    /* translation unit (the stream operators are in Fraction.cpp).     */
+    /********************************************************************/
+
+    template <typename IntT, typename Policy>
+    constexpr BasicFraction<IntT, Policy>::BasicFraction(): _numerator(0), _denominator(1) {}
+
+    template <typename IntT, typename Policy>
+    constexpr BasicFraction<IntT, Policy>::BasicFraction(float number): _numerator(_scale(number)), _denominator(_float_scale) {
+        _reduce();
+    }
+
+    template <typename IntT, typename Policy>
+    template <typename Number> requires (std::is_floating_point_v<Number> && !std::is_same_v<Number, float>)
+    constexpr BasicFraction<IntT, Policy>::BasicFraction(Number number): _numerator(_scale_rounded(static_cast<double>(number))), _denominator(_float_scale) {
+        _reduce();
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr BasicFraction<IntT, Policy>::BasicFraction(IntT numerator, IntT denominator): _numerator(numerator), _denominator(denominator) {
+        if (denominator == 0)
+            ARIEL_FRACTION_THROW(std::invalid_argument("Denominator can't be zero"));
+
+        // Reduce the magnitudes before fixing the sign: negating min_int overflows, but its reduced part may fit (min_int / -10).
+        UIntT num_magnitude = _magnitude(numerator), den_magnitude = _magnitude(denominator);
+        const UIntT gcd_fact = gcd::gcd(num_magnitude, den_magnitude);
+        num_magnitude /= gcd_fact;
+        den_magnitude /= gcd_fact;
+
+        const bool negative = (numerator < 0) != (denominator < 0);
+
+        _numerator = _with_sign(num_magnitude, negative);
+        _denominator = static_cast<IntT>(den_magnitude);
+
+        // Like the operators, the policy resolves a reduced fraction that doesn't fit (3 / min_int or min_int / -1).
+        if (den_magnitude > static_cast<UIntT>(max_int) || num_magnitude > static_cast<UIntT>(max_int) + (negative ? 1U : 0U))
+            *this = Policy::resolve(true, *this, [=] { return _saturate(num_magnitude, den_magnitude, negative); }, "Fraction overflow");
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr IntT BasicFraction<IntT, Policy>::getNumerator() const {
+        return _numerator;
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr IntT BasicFraction<IntT, Policy>::getDenominator() const {
+        return _denominator;
+    }
+
+
+    // Operators with fractions
+
+    template <typename IntT, typename Policy>
+    constexpr std::strong_ordering BasicFraction<IntT, Policy>::_compare_ratios(UIntT num1, UIntT den1, UIntT num2, UIntT den2) {
+        // Compare the integer parts, then the reciprocals of the remainders (which flips the order).
+        bool flipped = false;
+
+        while (true)
+        {
+            UIntT quot1 = num1 / den1, quot2 = num2 / den2;
+
+            if (quot1 != quot2)
+                return flipped ? (quot2 <=> quot1) : (quot1 <=> quot2);
+
+            UIntT rem1 = num1 % den1, rem2 = num2 % den2;
+
+            if (rem1 == 0 || rem2 == 0)
+                return flipped ? (rem2 <=> rem1) : (rem1 <=> rem2);
+
+            num1 = den1;
+            den1 = rem1;
+            num2 = den2;
+            den2 = rem2;
+            flipped = !flipped;
+        }
+    }
+
+    template <typename IntT, typename Policy>
+    template <typename Approximation>
+    constexpr BasicFraction<IntT, Policy> BasicFraction<IntT, Policy>::_from_wide(WideT numerator, WideT denominator, bool overflowed, Approximation approximation, const char* message) {
+        // The parts of an overflowed result are wrapped around, so they are resolved without reducing them.
+        if (!Policy::checked || !overflowed)
+            _reduce(numerator, denominator);
+
+        return _narrow_fraction(numerator, denominator, overflowed, approximation, message);
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr BasicFraction<IntT, Policy> BasicFraction<IntT, Policy>::_henrici_add(IntT num1, IntT den1, IntT num2, IntT den2, _Sum sum) {
+        bool overflowed = false;
+        const auto approximation = [=] {
+            return _approximate_sum(static_cast<long double>(num1) / den1, static_cast<long double>(num2) / den2, sum);
+        };
+
+        // a + b, a - b and b - a are all a + b with one of the numerators negated.
+        const WideT first = (sum == _Sum::Reverse) ? _negate(num1, overflowed) : WideT{num1};
+        const WideT second = (sum == _Sum::Subtract) ? _negate(num2, overflowed) : WideT{num2};
+
+        // Equal denominators (very common): (a + c) / b only needs gcd(a + c, b).
+        if (den1 == den2)
+        {
+            WideT numerator = _add(first, second, overflowed);
+            return _from_wide(numerator, den1, overflowed, approximation, "Addition overflow");
+        }
+
+        IntT gcd_den = _gcd(den1, den2);
+
+        // Coprime denominators: (a*d + c*b) / (b*d) is already reduced.
+        if (gcd_den == 1)
+        {
+            WideT numerator = _add(_mul(first, den2, overflowed), _mul(second, den1, overflowed), overflowed);
+            WideT denominator = _mul(den1, den2, overflowed);
+
+            return _narrow_fraction(numerator, denominator, overflowed, approximation, "Addition overflow");
+        }
+
+        // t = a*(d/g) + c*(b/g), and only gcd(t, g) can still divide the result.
+        WideT numerator = _add(_mul(first, den2 / gcd_den, overflowed), _mul(second, den1 / gcd_den, overflowed), overflowed);
+        auto gcd_num = static_cast<IntT>(_gcd_wide(_magnitude(numerator), static_cast<UWideT>(gcd_den)));
+
+        numerator /= gcd_num;
+        WideT denominator = _mul(den1 / gcd_den, den2 / gcd_num, overflowed);
+
+        return _narrow_fraction(numerator, denominator, overflowed, approximation, "Addition overflow");
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr const BasicFraction<IntT, Policy> BasicFraction<IntT, Policy>::operator+(const BasicFraction& other) const {
+        return _henrici_add(_numerator, _denominator, other._numerator, other._denominator, _Sum::Add);
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr const BasicFraction<IntT, Policy> BasicFraction<IntT, Policy>::operator-(const BasicFraction& other) const {
+        return _henrici_add(_numerator, _denominator, other._numerator, other._denominator, _Sum::Subtract);
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr const BasicFraction<IntT, Policy> BasicFraction<IntT, Policy>::operator*(const BasicFraction& other) const {
+        // Knuth's cross-cancellation: (a/b) * (c/d) = ((a/g1) * (c/g2)) / ((b/g2) * (d/g1))
+        // with g1 = gcd(a, d) and g2 = gcd(c, b). The product of reduced fractions is then already reduced.
+        IntT gcd1 = _gcd(_numerator, other._denominator);
+        IntT gcd2 = _gcd(other._numerator, _denominator);
+
+        bool overflowed = false;
+        WideT numerator = _mul(_numerator / gcd1, other._numerator / gcd2, overflowed);
+        WideT denominator = _mul(_denominator / gcd2, other._denominator / gcd1, overflowed);
+
+        return _narrow_fraction(numerator, denominator, overflowed, [this, &other] {
+            return static_cast<long double>(_numerator) / _denominator * (static_cast<long double>(other._numerator) / other._denominator);
+        }, "Multiplication overflow");
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr const BasicFraction<IntT, Policy> BasicFraction<IntT, Policy>::operator/(const BasicFraction& other) const {
+        if (other._numerator == 0)
+            ARIEL_FRACTION_THROW(std::runtime_error("Can't divide by zero"));
+
+        // Multiplication by the reciprocal d/c, cross-cancelled with g1 = gcd(a, c) and g2 = gcd(d, b).
+        IntT gcd1 = _gcd(_numerator, other._numerator);
+        IntT gcd2 = _gcd(other._denominator, _denominator);
+
+        bool overflowed = false;
+        WideT numerator = _mul(_numerator / gcd1, other._denominator / gcd2, overflowed);
+        WideT denominator = _mul(_denominator / gcd2, other._numerator / gcd1, overflowed);
+
+        if (denominator < 0)
+        {
+            numerator = _negate(numerator, overflowed);
+            denominator = _negate(denominator, overflowed);
+        }
+
+        return _narrow_fraction(numerator, denominator, overflowed, [this, &other] {
+            return static_cast<long double>(_numerator) / _denominator / (static_cast<long double>(other._numerator) / other._denominator);
+        }, "Division overflow");
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr BasicFraction<IntT, Policy>& BasicFraction<IntT, Policy>::operator++() {
+        // (n + d) / d is already reduced, gcd(n + d, d) = gcd(n, d) = 1.
+        return _assign(_add_integer(_numerator, _denominator, 1, _Sum::Add));
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr BasicFraction<IntT, Policy> BasicFraction<IntT, Policy>::operator++(int) {
+        BasicFraction temp = *this;
+        ++(*this);
+        return temp;
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr BasicFraction<IntT, Policy>& BasicFraction<IntT, Policy>::operator--() {
+        // (n - d) / d is already reduced, gcd(n - d, d) = gcd(n, d) = 1.
+        return _assign(_add_integer(_numerator, _denominator, 1, _Sum::Subtract));
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr BasicFraction<IntT, Policy> BasicFraction<IntT, Policy>::operator--(int) {
+        BasicFraction temp = *this;
+        --(*this);
+        return temp;
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr bool BasicFraction<IntT, Policy>::operator==(const BasicFraction& other) const {
+        return (_numerator == other._numerator) && (_denominator == other._denominator);
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr std::strong_ordering BasicFraction<IntT, Policy>::operator<=>(const BasicFraction& other) const {
+        // Different signs: the numerators alone decide.
+        if ((_numerator ^ other._numerator) < 0)
+            return _numerator <=> other._numerator;
+
+        if (_denominator == other._denominator)
+            return _numerator <=> other._numerator;
+
+        if constexpr (_is_widened)
+            return static_cast<WideT>(_numerator) * other._denominator <=> static_cast<WideT>(other._numerator) * _denominator;
+
+        else
+        {
+            // Same signs: compare the magnitudes, in reverse for negative fractions.
+            auto ordering = _compare_ratios(_magnitude(_numerator), static_cast<UIntT>(_denominator), _magnitude(other._numerator), static_cast<UIntT>(other._denominator));
+            return (_numerator < 0) ? (0 <=> ordering) : ordering;
+        }
+    }
+
+
+    // Checked operations
+
+    template <typename IntT, typename Policy>
+    template <typename Operation>
+    Result<BasicFraction<IntT, Policy>> BasicFraction<IntT, Policy>::_checked(Operation operation) noexcept {
+        const bool outer_flag = overflow::occurred();
+        overflow::clear();
+
+        const _Flagging result = operation();
+        const bool overflowed = overflow::occurred();
+        overflow::detail::flag = outer_flag;
+
+        if (overflowed)
+            return FractionError::Overflow;
+
+        return BasicFraction(result._numerator, result._denominator, _reduced_tag{});
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr FractionError BasicFraction<IntT, Policy>::_parse_integer(std::string_view& text, IntT& num) noexcept {
+        constexpr int base = 10;
+        std::size_t pos = 0;
+        bool negative = false;
+
+        while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n'))
+            ++pos;
+
+        if (pos < text.size() && (text[pos] == '-' || text[pos] == '+'))
+            negative = (text[pos++] == '-');
+
+        const UIntT limit = static_cast<UIntT>(max_int) + (negative ? 1U : 0U);
+        const std::size_t first_digit = pos;
+        UIntT magnitude = 0;
+
+        for (; pos < text.size() && text[pos] >= '0' && text[pos] <= '9'; ++pos)
+        {
+            auto digit = static_cast<UIntT>(text[pos] - '0');
+
+            if (magnitude > (limit - digit) / base)
+                return FractionError::Overflow;
+
+            magnitude = static_cast<UIntT>(magnitude * base + digit);
+        }
+
+        if (pos == first_digit)
+            return FractionError::InvalidInput;
+
+        num = negative ? static_cast<IntT>(UIntT{0} - magnitude) : static_cast<IntT>(magnitude);
+        text.remove_prefix(pos);
+        return FractionError::None;
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr Result<BasicFraction<IntT, Policy>> BasicFraction<IntT, Policy>::checked_make(IntT numerator, IntT denominator) noexcept {
+        if (denominator == 0)
+            return FractionError::ZeroDenominator;
+
+        // Reduce the magnitudes first, so e.g. 2/INT_MIN still works.
+        UIntT num_magnitude = _magnitude(numerator), den_magnitude = _magnitude(denominator);
+        const UIntT gcd_fact = gcd::gcd(num_magnitude, den_magnitude);
+        num_magnitude /= gcd_fact;
+        den_magnitude /= gcd_fact;
+
+        const bool negative = (numerator < 0) != (denominator < 0);
+
+        if (den_magnitude > static_cast<UIntT>(max_int) || num_magnitude > static_cast<UIntT>(max_int) + (negative ? 1U : 0U))
+            return FractionError::Overflow;
+
+        return BasicFraction(negative ? static_cast<IntT>(UIntT{0} - num_magnitude) : static_cast<IntT>(num_magnitude), static_cast<IntT>(den_magnitude), _reduced_tag{});
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr Result<BasicFraction<IntT, Policy>> BasicFraction<IntT, Policy>::checked_parse(std::string_view text) noexcept {
+        IntT numerator = 0, denominator = 0;
+
+        if (auto error = _parse_integer(text, numerator); error != FractionError::None)
+            return error;
+
+        if (!text.empty() && text.front() == '/')
+            text.remove_prefix(1);
+
+        if (auto error = _parse_integer(text, denominator); error != FractionError::None)
+            return error;
+
+        if (text.find_first_not_of(" \t\n") != std::string_view::npos)
+            return FractionError::InvalidInput;
+
+        return checked_make(numerator, denominator);
+    }
+
+    template <typename IntT, typename Policy>
+    Result<BasicFraction<IntT, Policy>> BasicFraction<IntT, Policy>::checked_add(const BasicFraction& num1, const BasicFraction& num2) noexcept {
+        return _checked([&] { return _Flagging::_henrici_add(num1._numerator, num1._denominator, num2._numerator, num2._denominator, _Flagging::_Sum::Add); });
+    }
+
+    template <typename IntT, typename Policy>
+    Result<BasicFraction<IntT, Policy>> BasicFraction<IntT, Policy>::checked_sub(const BasicFraction& num1, const BasicFraction& num2) noexcept {
+        return _checked([&] { return _Flagging::_henrici_add(num1._numerator, num1._denominator, num2._numerator, num2._denominator, _Flagging::_Sum::Subtract); });
+    }
+
+    template <typename IntT, typename Policy>
+    Result<BasicFraction<IntT, Policy>> BasicFraction<IntT, Policy>::checked_mul(const BasicFraction& num1, const BasicFraction& num2) noexcept {
+        return _checked([&] { return _Flagging(num1._numerator, num1._denominator, typename _Flagging::_reduced_tag{}) * _Flagging(num2._numerator, num2._denominator, typename _Flagging::_reduced_tag{}); });
+    }
+
+    template <typename IntT, typename Policy>
+    Result<BasicFraction<IntT, Policy>> BasicFraction<IntT, Policy>::checked_div(const BasicFraction& num1, const BasicFraction& num2) noexcept {
+        if (num2._numerator == 0)
+            return FractionError::DivisionByZero;
+
+        return _checked([&] { return _Flagging(num1._numerator, num1._denominator, typename _Flagging::_reduced_tag{}) / _Flagging(num2._numerator, num2._denominator, typename _Flagging::_reduced_tag{}); });
+    }
+
+
+    // Fused operations
+
+    template <typename IntT, typename Policy>
+    constexpr BasicFraction<IntT, Policy> BasicFraction<IntT, Policy>::_from_int128(int128_t numerator, int128_t denominator) {
+        const uint128_t num_magnitude = _magnitude(numerator), den_magnitude = static_cast<uint128_t>(denominator);
+
+        // The narrow engine is cheaper when both parts fit in 64 bits.
+        const auto gcd_fact = static_cast<int128_t>((((num_magnitude | den_magnitude) >> std::numeric_limits<std::uint64_t>::digits) == 0)
+            ? gcd::gcd(static_cast<std::uint64_t>(num_magnitude), static_cast<std::uint64_t>(den_magnitude))
+            : gcd::gcd(num_magnitude, den_magnitude));
+
+        numerator /= gcd_fact;
+        denominator /= gcd_fact;
+
+        return _narrow_fraction(numerator, denominator);
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr BasicFraction<IntT, Policy> BasicFraction<IntT, Policy>::fma(const BasicFraction& num1, const BasicFraction& num2, const BasicFraction& num3) {
+        int128_t product_num{}, product_den{}, numerator{}, term{}, denominator{};
+
+        const bool overflowed = __builtin_mul_overflow(static_cast<int128_t>(num1._numerator), num2._numerator, &product_num)
+            || __builtin_mul_overflow(static_cast<int128_t>(num1._denominator), num2._denominator, &product_den)
+            || __builtin_mul_overflow(product_num, num3._denominator, &numerator)
+            || __builtin_mul_overflow(product_den, num3._numerator, &term)
+            || __builtin_add_overflow(numerator, term, &numerator)
+            || __builtin_mul_overflow(product_den, num3._denominator, &denominator);
+
+        if (overflowed)
+            return num1 * num2 + num3;
+
+        return _from_int128(numerator, denominator);
+    }
+
+    // Conversions from double values
+
+    template <typename IntT, typename Policy>
+    constexpr bool BasicFraction<IntT, Policy>::_decompose(double number, std::uint64_t& mantissa, int& exponent, bool& negative) noexcept {
+        constexpr int mantissa_bits = std::numeric_limits<double>::digits - 1;
+        constexpr int exponent_bias = std::numeric_limits<double>::max_exponent - 1 + mantissa_bits;
+        constexpr std::uint64_t exponent_mask = (std::uint64_t{1} << (std::numeric_limits<std::uint64_t>::digits - 1 - mantissa_bits)) - 1;
+        constexpr std::uint64_t mantissa_mask = (std::uint64_t{1} << mantissa_bits) - 1;
+
+        const auto bits = std::bit_cast<std::uint64_t>(number);
+        const auto biased_exponent = static_cast<int>((bits >> mantissa_bits) & exponent_mask);
+
+        negative = (bits >> (std::numeric_limits<std::uint64_t>::digits - 1)) != 0;
+
+        if (biased_exponent == static_cast<int>(exponent_mask))
+            return false;
+
+        // Subnormal numbers have no implicit leading bit and the exponent of the smallest normal number.
+        mantissa = bits & mantissa_mask;
+        exponent = 1 - exponent_bias;
+
+        if (biased_exponent != 0)
+        {
+            mantissa |= std::uint64_t{1} << mantissa_bits;
+            exponent = biased_exponent - exponent_bias;
+        }
+
+        if (mantissa != 0)
+        {
+            const int zeros = std::countr_zero(mantissa);
+            mantissa >>= zeros;
+            exponent += zeros;
+        }
+
+        return true;
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr BasicFraction<IntT, Policy> BasicFraction<IntT, Policy>::from_double_exact(double number) {
+        std::uint64_t mantissa = 0;
+        int exponent = 0;
+        bool negative = false;
+
+        if (!_decompose(number, mantissa, exponent, negative))
+            ARIEL_FRACTION_THROW(std::invalid_argument("Number must be finite"));
+
+        if (mantissa == 0)
+            return BasicFraction();
+
+        const uint128_t limit = static_cast<uint128_t>(max_int) + (negative ? 1U : 0U);
+
+        if (exponent >= 0)
+        {
+            if (gcd::bit_width(mantissa) + exponent > std::numeric_limits<IntT>::digits + 1)
+                ARIEL_FRACTION_THROW(std::overflow_error("Fraction overflow"));
+
+            const uint128_t magnitude = static_cast<uint128_t>(mantissa) << exponent;
+
+            if (magnitude > limit)
+                ARIEL_FRACTION_THROW(std::overflow_error("Fraction overflow"));
+
+            return BasicFraction(_with_sign(magnitude, negative), 1, _reduced_tag{});
+        }
+
+        // The denominator 2^-exponent must fit in IntT too.
+        if (-exponent >= std::numeric_limits<IntT>::digits || mantissa > limit)
+            ARIEL_FRACTION_THROW(std::overflow_error("Fraction overflow"));
+
+        return BasicFraction(_with_sign(mantissa, negative), static_cast<IntT>(IntT{1} << -exponent), _reduced_tag{});
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr BasicFraction<IntT, Policy> BasicFraction<IntT, Policy>::from_double_rounded(double number, IntT max_denominator) {
+        constexpr int max_shift = std::numeric_limits<uint128_t>::digits - 1;
+        std::uint64_t mantissa = 0;
+        int exponent = 0;
+        bool negative = false;
+
+        if (max_denominator < 1)
+            ARIEL_FRACTION_THROW(std::invalid_argument("Maximal denominator must be positive"));
+
+        if (!_decompose(number, mantissa, exponent, negative))
+            ARIEL_FRACTION_THROW(std::invalid_argument("Number must be finite"));
+
+        // Integers are exact.
+        if (mantissa == 0 || exponent >= 0)
+            return from_double_exact(number);
+
+        // The exact value is mantissa / 2^shift. Far below 2^-64 the lowest bits are dropped to fit in 128 bits.
+        int shift = -exponent;
+
+        if (shift > max_shift)
+        {
+            if (shift - max_shift >= std::numeric_limits<std::uint64_t>::digits)
+                return BasicFraction();
+
+            mantissa >>= (shift - max_shift);
+            shift = max_shift;
+        }
+
+        const uint128_t max_num = static_cast<uint128_t>(max_int) + (negative ? 1U : 0U);
+        const auto max_den = static_cast<uint128_t>(max_denominator);
+
+        if (shift < std::numeric_limits<std::uint64_t>::digits && (mantissa >> shift) > max_num)
+            ARIEL_FRACTION_THROW(std::overflow_error("Fraction overflow"));
+
+        if (shift < std::numeric_limits<std::uint64_t>::digits && max_num <= std::numeric_limits<std::uint64_t>::max())
+            return _best_approximation<std::uint64_t>(mantissa, std::uint64_t{1} << shift, static_cast<std::uint64_t>(max_num), static_cast<std::uint64_t>(max_den), negative);
+
+        return _best_approximation<uint128_t>(mantissa, uint128_t{1} << shift, max_num, max_den, negative);
+    }
+
+    template <typename IntT, typename Policy>
+    template <typename U>
+    constexpr BasicFraction<IntT, Policy> BasicFraction<IntT, Policy>::_best_approximation(U rem_num, U rem_den, U max_num, U max_den, bool negative) {
+        using Ratio = std::conditional_t<(std::numeric_limits<U>::digits > std::numeric_limits<std::uint64_t>::digits), BasicFraction<int128_t>, BasicFraction<long long>>;
+
+        // The last two convergents p0/q0 and p1/q1, the value is (p1 * t + p0) / (q1 * t + q0) with t = rem_num / rem_den.
+        U num0 = 0, den0 = 1, num1 = 1, den1 = 0;
+
+        while (true)
+        {
+            const U quot = rem_num / rem_den;
+
+            // The largest k for which (p0 + k * p1) / (q0 + k * q1) still fits.
+            U bound = std::numeric_limits<U>::max();
+
+            if (den1 != 0)
+                bound = (max_den - den0) / den1;
+
+            if (num1 != 0)
+                bound = std::min(bound, (max_num - num0) / num1);
+
+            if (quot > bound)
+            {
+                // The semiconvergent is closer than p1/q1 iff t < 2k + q0/q1.
+                bool semiconvergent = bound > quot - bound;
+
+                if (!semiconvergent && den1 != 0)
+                    semiconvergent = Ratio::_compare_ratios(rem_num - bound * rem_den - bound * rem_den, rem_den, den0, den1) < 0;
+
+                if (semiconvergent)
+                    return BasicFraction(_with_sign(num0 + bound * num1, negative), static_cast<IntT>(den0 + bound * den1), _reduced_tag{});
+
+                return BasicFraction(_with_sign(num1, negative), static_cast<IntT>(den1), _reduced_tag{});
+            }
+
+            const U next_num = num0 + quot * num1, next_den = den0 + quot * den1;
+            num0 = num1;
+            den0 = den1;
+            num1 = next_num;
+            den1 = next_den;
+
+            const U next_rem = rem_num - quot * rem_den;
+            rem_num = rem_den;
+            rem_den = next_rem;
+
+            // The expansion ended, the fraction is exact.
+            if (rem_den == 0)
+                return BasicFraction(_with_sign(num1, negative), static_cast<IntT>(den1), _reduced_tag{});
+        }
+    }
+
+
+    // Conversions to floating point values
+
+    template <typename IntT, typename Policy>
+    template <typename FloatT>
+    constexpr FloatT BasicFraction<IntT, Policy>::_to_floating() const {
+        constexpr int precision = std::numeric_limits<FloatT>::digits;
+        constexpr int min_exponent = std::numeric_limits<FloatT>::min_exponent - 1;
+        constexpr UIntT top_bit = UIntT{1} << (std::numeric_limits<UIntT>::digits - 1);
+
+        if (_fits_double(_numerator, _denominator))
+            return static_cast<FloatT>(static_cast<double>(_numerator) / static_cast<double>(_denominator));
+
+        UIntT num = _magnitude(_numerator);
+        auto den = static_cast<UIntT>(_denominator);
+
+        // Align both parts to the same bit width, the value is num / den * 2^exponent with num / den in (1/2, 2).
+        int exponent = gcd::bit_width(num) - gcd::bit_width(den);
+
+        if (exponent >= 0)
+            den <<= exponent;
+
+        else
+            num <<= -exponent;
+
+        // num / den in (1/2, 1) takes one more quotient bit.
+        const bool below = num < den;
+        exponent -= below ? 1 : 0;
+
+        // Subnormal results have fewer significant bits.
+        const int bits = std::min(precision, exponent - min_exponent + precision);
+
+        // The significant bits and one rounding bit, and whether a remainder is left (the sticky bit).
+        std::uint64_t mantissa = 0;
+        bool sticky = false;
+
+        if constexpr (std::numeric_limits<UIntT>::digits <= std::numeric_limits<std::uint64_t>::digits)
+        {
+            // A single 128 by 64-bit division gives all of them at once.
+            const uint128_t dividend = static_cast<uint128_t>(num) << (bits + (below ? 1 : 0));
+            mantissa = static_cast<std::uint64_t>(dividend / den);
+            sticky = dividend % den != 0;
+        }
+
+        else
+        {
+            // Binary long division (the same quotient, the first bit is 0 if below), branch free since the bits
+            // are unpredictable. The bit shifted out of num is kept in carry, then the true remainder is
+            // num + 2^digits, and the wrapped difference is still exact.
+            const int steps = bits + (below ? 1 : 0);
+            bool carry = false;
+
+            for (int i = 0; i <= steps; ++i)
+            {
+                if (i > 0)
+                {
+                    carry = (num & top_bit) != 0;
+                    num <<= 1;
+                }
+
+                const bool bit = carry || num >= den;
+                num -= den & (UIntT{0} - static_cast<UIntT>(bit));
+                mantissa = (mantissa << 1) | static_cast<std::uint64_t>(bit);
+            }
+
+            sticky = num != 0;
+        }
+
+        const bool round = (mantissa & 1) != 0;
+        mantissa >>= 1;
+
+        if (round && (sticky || (mantissa & 1) != 0))
+            ++mantissa;
+
+        // Exact in double (and in FloatT), even if rounding carried into a new top bit.
+        const double result = static_cast<double>(mantissa) * _power_of_two(exponent - bits + 1);
+        return static_cast<FloatT>((_numerator < 0) ? -result : result);
+    }
+
+    template <typename IntT, typename Policy>
+    template <typename FloatT>
+    constexpr void BasicFraction<IntT, Policy>::_to_floating(std::span<const BasicFraction> fractions, std::span<FloatT> results) {
+        if (results.size() < fractions.size())
+            ARIEL_FRACTION_THROW(std::invalid_argument("Results must be at least as long as the fractions"));
+
+        // Fixed size blocks, so the compiler vectorizes them at -O2 as well (its cheapest cost model needs a known trip count).
+        constexpr std::size_t block = 8;
+        const auto convert = [&](std::size_t i) {
+            results[i] = static_cast<FloatT>(static_cast<double>(fractions[i]._numerator) / static_cast<double>(fractions[i]._denominator));
+        };
+
+        std::size_t index = 0;
+
+        for (; index + block <= fractions.size(); index += block)
+        {
+            for (std::size_t i = index; i < index + block; ++i)
+                convert(i);
+        }
+
+        for (; index < fractions.size(); ++index)
+            convert(index);
+
+        if constexpr (std::numeric_limits<IntT>::digits > std::numeric_limits<double>::digits)
+        {
+            for (std::size_t i = 0; i < fractions.size(); ++i)
+            {
+                if (!_fits_double(fractions[i]._numerator, fractions[i]._denominator))
+                    results[i] = fractions[i].template _to_floating<FloatT>();
+            }
+        }
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr double BasicFraction<IntT, Policy>::to_double() const {
+        return _to_floating<double>();
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr float BasicFraction<IntT, Policy>::to_float() const {
+        return _to_floating<float>();
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr void BasicFraction<IntT, Policy>::to_double(std::span<const BasicFraction> fractions, std::span<double> results) {
+        _to_floating<double>(fractions, results);
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr void BasicFraction<IntT, Policy>::to_float(std::span<const BasicFraction> fractions, std::span<float> results) {
+        _to_floating<float>(fractions, results);
+    }
+
+
+    // Operators with floats - the float is the scaled integer k / 1000, combined directly with the fraction
+
+    template <typename IntT, typename Policy>
+    constexpr const BasicFraction<IntT, Policy> BasicFraction<IntT, Policy>::operator+(const float& other) const {
+        return _add_scaled(_numerator, _denominator, _scale(other), _Sum::Add);
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr const BasicFraction<IntT, Policy> BasicFraction<IntT, Policy>::operator-(const float& other) const {
+        return _add_scaled(_numerator, _denominator, _scale(other), _Sum::Subtract);
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr const BasicFraction<IntT, Policy> BasicFraction<IntT, Policy>::operator*(const float& other) const {
+        return _from_quotient(_numerator, _scale(other), _denominator, _float_scale, "Multiplication overflow");
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr const BasicFraction<IntT, Policy> BasicFraction<IntT, Policy>::operator/(const float& other) const {
+        const IntT scaled = _scale(other);
+
+        // Also catches floats that truncate to 0 (|x| < 0.001), like the temporary fraction did.
+        if (scaled == 0)
+            ARIEL_FRACTION_THROW(std::runtime_error("Can't divide by zero"));
+
+        // (a / b) / (k / 1000) = (a * 1000) / (b * k)
+        return _from_quotient(_numerator, _float_scale, _denominator, scaled, "Division overflow");
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr bool BasicFraction<IntT, Policy>::operator==(const float& other) const {
+        return _compare_double(other) == 0;
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr std::strong_ordering BasicFraction<IntT, Policy>::operator<=>(const float& other) const {
+        return _compare_double(other);
+    }
+
+
+    // Operators with integers and doubles
+
+    template <typename IntT, typename Policy>
+    template <typename Number> requires detail::fraction_scalar<Number>
+    constexpr const BasicFraction<IntT, Policy> BasicFraction<IntT, Policy>::operator+(const Number& num) const {
+        if constexpr (std::numeric_limits<Number>::is_integer)
+            return _add_integer(_numerator, _denominator, num, _Sum::Add);
+
+        else
+            return _add_scaled(_numerator, _denominator, _scale_rounded(static_cast<double>(num)), _Sum::Add);
+    }
+
+    template <typename IntT, typename Policy>
+    template <typename Number> requires detail::fraction_scalar<Number>
+    constexpr const BasicFraction<IntT, Policy> BasicFraction<IntT, Policy>::operator-(const Number& num) const {
+        if constexpr (std::numeric_limits<Number>::is_integer)
+            return _add_integer(_numerator, _denominator, num, _Sum::Subtract);
+
+        else
+            return _add_scaled(_numerator, _denominator, _scale_rounded(static_cast<double>(num)), _Sum::Subtract);
+    }
+
+    template <typename IntT, typename Policy>
+    template <typename Number> requires detail::fraction_scalar<Number>
+    constexpr const BasicFraction<IntT, Policy> BasicFraction<IntT, Policy>::operator*(const Number& num) const {
+        if constexpr (std::numeric_limits<Number>::is_integer)
+            return _mul_integer(_numerator, _denominator, num);
+
+        else
+            return _from_quotient(_numerator, _scale_rounded(static_cast<double>(num)), _denominator, _float_scale, "Multiplication overflow");
+    }
+
+    template <typename IntT, typename Policy>
+    template <typename Number> requires detail::fraction_scalar<Number>
+    constexpr const BasicFraction<IntT, Policy> BasicFraction<IntT, Policy>::operator/(const Number& num) const {
+        if constexpr (std::numeric_limits<Number>::is_integer)
+        {
+            if (num == 0)
+                ARIEL_FRACTION_THROW(std::runtime_error("Can't divide by zero"));
+
+            // (a / b) / n = (a / g) / (b * (n / g)) with g = gcd(a, n), reduced since a and b are coprime.
+            return _div_integer(_numerator, _denominator, num);
+        }
+
+        else
+        {
+            const IntT scaled = _scale_rounded(static_cast<double>(num));
+
+            if (scaled == 0)
+                ARIEL_FRACTION_THROW(std::runtime_error("Can't divide by zero"));
+
+            return _from_quotient(_numerator, _float_scale, _denominator, scaled, "Division overflow");
+        }
+    }
+
+    template <typename IntT, typename Policy>
+    template <typename Number> requires detail::fraction_scalar<Number>
+    constexpr bool BasicFraction<IntT, Policy>::operator==(const Number& num) const {
+        // A reduced fraction equals an integer only if its denominator is 1 (and the integer fits in WideT).
+        if constexpr (std::numeric_limits<Number>::is_integer)
+        {
+            bool overflowed = false;
+            const WideT integer = _widen(num, overflowed);
+            return !overflowed && _denominator == 1 && static_cast<WideT>(_numerator) == integer;
+        }
+
+        else
+            return *this <=> num == 0;
+    }
+
+    template <typename IntT, typename Policy>
+    template <typename Number> requires detail::fraction_scalar<Number>
+    constexpr std::strong_ordering BasicFraction<IntT, Policy>::operator<=>(const Number& num) const {
+        if constexpr (std::numeric_limits<Number>::is_integer)
+        {
+            // Integers beyond WideT are beyond every fraction, only their sign decides.
+            bool overflowed = false;
+            const WideT integer = _widen(num, overflowed);
+
+            if (overflowed)
+                return (num > 0) ? std::strong_ordering::less : std::strong_ordering::greater;
+
+            // a / b <=> n is a <=> n * b, and if n * b overflows, n alone decides.
+            WideT product{};
+
+            if (__builtin_mul_overflow(integer, _denominator, &product))
+                return (integer < 0) ? std::strong_ordering::greater : std::strong_ordering::less;
+
+            return static_cast<WideT>(_numerator) <=> product;
+        }
+
+        else
+            return _compare_double(static_cast<double>(num));
+    }
+
+
+    // Compound assignment operators - the same kernels as the binary operators, then stored in the current fraction
+
+    template <typename IntT, typename Policy>
+    constexpr BasicFraction<IntT, Policy>& BasicFraction<IntT, Policy>::operator+=(const BasicFraction& other) {
+        return _assign(*this + other);
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr BasicFraction<IntT, Policy>& BasicFraction<IntT, Policy>::operator+=(const float& num) {
+        return _assign(*this + num);
+    }
+
+    template <typename IntT, typename Policy>
+    template <typename Number> requires detail::fraction_scalar<Number>
+    constexpr BasicFraction<IntT, Policy>& BasicFraction<IntT, Policy>::operator+=(const Number& num) {
+        return _assign(*this + num);
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr BasicFraction<IntT, Policy>& BasicFraction<IntT, Policy>::operator-=(const BasicFraction& other) {
+        return _assign(*this - other);
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr BasicFraction<IntT, Policy>& BasicFraction<IntT, Policy>::operator-=(const float& num) {
+        return _assign(*this - num);
+    }
+
+    template <typename IntT, typename Policy>
+    template <typename Number> requires detail::fraction_scalar<Number>
+    constexpr BasicFraction<IntT, Policy>& BasicFraction<IntT, Policy>::operator-=(const Number& num) {
+        return _assign(*this - num);
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr BasicFraction<IntT, Policy>& BasicFraction<IntT, Policy>::operator*=(const BasicFraction& other) {
+        return _assign(*this * other);
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr BasicFraction<IntT, Policy>& BasicFraction<IntT, Policy>::operator*=(const float& num) {
+        return _assign(*this * num);
+    }
+
+    template <typename IntT, typename Policy>
+    template <typename Number> requires detail::fraction_scalar<Number>
+    constexpr BasicFraction<IntT, Policy>& BasicFraction<IntT, Policy>::operator*=(const Number& num) {
+        return _assign(*this * num);
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr BasicFraction<IntT, Policy>& BasicFraction<IntT, Policy>::operator/=(const BasicFraction& other) {
+        return _assign(*this / other);
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr BasicFraction<IntT, Policy>& BasicFraction<IntT, Policy>::operator/=(const float& num) {
+        return _assign(*this / num);
+    }
+
+    template <typename IntT, typename Policy>
+    template <typename Number> requires detail::fraction_scalar<Number>
+    constexpr BasicFraction<IntT, Policy>& BasicFraction<IntT, Policy>::operator/=(const Number& num) {
+        return _assign(*this / num);
+    }
+}
+
+/*
+ * @brief Hashes a fraction by its reduced numerator and denominator (equal fractions are always reduced the same way).
+*/
+template <typename IntT, typename Policy>
+struct std::hash<ariel::BasicFraction<IntT, Policy>>
+{
+    constexpr std::size_t operator()(const ariel::BasicFraction<IntT, Policy>& fraction) const noexcept {
+        return static_cast<std::size_t>(ariel::detail::hash_fraction(fraction.getNumerator(), fraction.getDenominator()));
+    }
+};
@@ -0,0 +1,203 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include "Fraction.hpp"
+
+namespace ariel
+{
+    /*
+     * @brief Sums fractions and products of fractions exactly, with a single reduction at the end.
+     * @note The running sum is an unreduced 128-bit numerator and denominator. A term with the same denominator
+     *       is a single addition, any other term is cross multiplied, and only when that would overflow 128 bits
+     *       are the sum and the term reduced and added over the least common multiple of their denominators.
+     * @note IntT is at most 64 bits wide, so a product of two fractions always fits in 128 bits.
+     * @note The policy only applies to the final result, an overflow of the 128-bit sum always throws.
+    */
+    template <typename IntT, typename Policy = overflow::ThrowOnOverflow>
+    class BasicFractionAccumulator
+    {
+        public:
+            /*
+             * @brief The type of the accumulated fractions.
+            */
+            using fraction_type = BasicFraction<IntT, Policy>;
+
+        private:
+            static_assert(std::numeric_limits<IntT>::digits < std::numeric_limits<std::uint64_t>::digits,
+                "BasicFractionAccumulator needs products of two fractions to fit in 128 bits (int, long or long long)");
+
+            /*
+             * @brief The numerator of the sum (unreduced).
+            */
+            int128_t _numerator = 0;
+
+            /*
+             * @brief The denominator of the sum (unreduced, always positive).
+            */
+            int128_t _denominator = 1;
+
+            /*
+             * @brief Reduces a 128-bit fraction to its simplest form.
+             * @param numerator The numerator of the fraction.
+             * @param denominator The denominator of the fraction (positive).
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            static constexpr void _reduce(int128_t& numerator, int128_t& denominator) {
+                const uint128_t num_magnitude = (numerator < 0) ? uint128_t{0} - static_cast<uint128_t>(numerator) : static_cast<uint128_t>(numerator);
+                const auto gcd_fact = static_cast<int128_t>(gcd::gcd(num_magnitude, static_cast<uint128_t>(denominator)));
+
+                numerator /= gcd_fact;
+                denominator /= gcd_fact;
+            }
+
+            /*
+             * @brief Adds an unreduced term to the sum.
+             * @param numerator The numerator of the term.
+             * @param denominator The denominator of the term (positive).
+             * @throw overflow_error if the sum doesn't fit in 128 bits, even reduced.
+            */
+            constexpr void _add(int128_t numerator, int128_t denominator);
+
+        public:
+            /*
+             * @brief Default constructor of the BasicFractionAccumulator class.
+             * @note The sum starts at zero.
+            */
+            constexpr BasicFractionAccumulator() = default;
+
+            /*
+             * @brief Adds a fraction to the sum.
+             * @param fraction The fraction.
+            */
+            constexpr void add(const fraction_type& fraction) {
+                _add(fraction._numerator, fraction._denominator);
+            }
+
+            /*
+             * @brief Adds a product of two fractions to the sum (a fused multiply-add).
+             * @param num1 The first factor.
+             * @param num2 The second factor.
+             * @note The product is neither reduced nor overflow checked, it always fits in 128 bits.
+            */
+            constexpr void add_product(const fraction_type& num1, const fraction_type& num2) {
+                _add(static_cast<int128_t>(num1._numerator) * num2._numerator, static_cast<int128_t>(num1._denominator) * num2._denominator);
+            }
+
+            /*
+             * @brief Adds a fraction to the sum.
+             * @param fraction The fraction.
+             * @return BasicFractionAccumulator& The accumulator.
+            */
+            constexpr BasicFractionAccumulator& operator+=(const fraction_type& fraction) {
+                add(fraction);
+                return *this;
+            }
+
+            /*
+             * @brief Gets the sum.
+             * @return fraction_type The reduced sum (the only reduction, unless the sum neared overflow).
+             * @throw overflow_error if the reduced sum doesn't fit in IntT (with the default policy).
+            */
+            constexpr fraction_type result() const {
+                return fraction_type::_from_int128(_numerator, _denominator);
+            }
+
+            /*
+             * @brief Resets the sum to zero.
+            */
+            constexpr void reset() {
+                _numerator = 0;
+                _denominator = 1;
+            }
+
+            /*
+             * @brief Calculates the dot product of two arrays of fractions.
+             * @param first The first array.
+             * @param second The second array (of the same length).
+             * @return fraction_type The sum of first[i] * second[i].
+             * @throw invalid_argument if the arrays have different lengths.
+             * @throw overflow_error if the sum doesn't fit (with the default policy).
+            */
+            static constexpr fraction_type dot(std::span<const fraction_type> first, std::span<const fraction_type> second);
+    };
+
+    /*
+     * @brief An accumulator of int fractions.
+    */
+    using FractionAccumulator = BasicFractionAccumulator<int>;
+
+    template <typename IntT, typename Policy>
+    constexpr void BasicFractionAccumulator<IntT, Policy>::_add(int128_t numerator, int128_t denominator) {
+        // Equal denominators (e.g. weights in percents): no multiplication at all.
+        if (denominator == _denominator)
+        {
+            int128_t sum_num{};
+
+            if (!__builtin_add_overflow(_numerator, numerator, &sum_num))
+            {
+                _numerator = sum_num;
+                return;
+            }
+        }
+
+        else
+        {
+            int128_t sum_num{}, term{}, sum_den{};
+
+            if (!__builtin_mul_overflow(_numerator, denominator, &sum_num) && !__builtin_mul_overflow(numerator, _denominator, &term)
+                && !__builtin_add_overflow(sum_num, term, &sum_num) && !__builtin_mul_overflow(_denominator, denominator, &sum_den))
+            {
+                _numerator = sum_num;
+                _denominator = sum_den;
+                return;
+            }
+        }
+
+        // Near overflow: reduce both, and add over the least common multiple of the denominators.
+        _reduce(_numerator, _denominator);
+        _reduce(numerator, denominator);
+
+        const auto gcd_fact = static_cast<int128_t>(gcd::gcd(static_cast<uint128_t>(_denominator), static_cast<uint128_t>(denominator)));
+        int128_t sum_num{}, term{}, sum_den{};
+
+        if (__builtin_mul_overflow(_numerator, denominator / gcd_fact, &sum_num) || __builtin_mul_overflow(numerator, _denominator / gcd_fact, &term)
+            || __builtin_add_overflow(sum_num, term, &sum_num) || __builtin_mul_overflow(_denominator / gcd_fact, denominator, &sum_den))
+            ARIEL_FRACTION_THROW(std::overflow_error("Accumulator overflow"));
+
+        _numerator = sum_num;
+        _denominator = sum_den;
+    }
+
+    template <typename IntT, typename Policy>
+    constexpr typename BasicFractionAccumulator<IntT, Policy>::fraction_type BasicFractionAccumulator<IntT, Policy>::dot(std::span<const fraction_type> first, std::span<const fraction_type> second) {
+        if (first.size() != second.size())
+            ARIEL_FRACTION_THROW(std::invalid_argument("Arrays must have the same length"));
+
+        BasicFractionAccumulator accumulator;
+
+        for (std::size_t i = 0; i < first.size(); ++i)
+            accumulator.add_product(first[i], second[i]);
+
+        return accumulator.result();
+    }
+}
@@ -0,0 +1,847 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <stdexcept>
+#include "FractionArray.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ARIEL_FRACTION_ARRAY_X86 1
+#endif
+
+namespace ariel
+{
+    namespace
+    {
+        using Op = detail::FractionArrayOp;
+
+        /*
+         * @brief The number of fractions processed per block, the wide intermediate results of a block stay in L1.
+        */
+        constexpr std::size_t block_size = 512;
+
+        /*
+         * @brief The unreduced 64-bit results of a block and their gcds.
+         * @note The magnitudes of the parts are below 2^63 (sums of two products of ints at most).
+        */
+        struct WideBlock
+        {
+            alignas(FractionArray::alignment) std::int64_t numerators[block_size];
+            alignas(FractionArray::alignment) std::int64_t denominators[block_size];
+
+            /*
+             * @brief The gcd of each fraction's parts, 0 for a zero denominator (an invalid fraction).
+            */
+            alignas(FractionArray::alignment) std::uint64_t divisors[block_size];
+        };
+
+        /*
+         * @brief The fractions of a block whose gcd needs the binary gcd loop, prepared for the lanes:
+         *        the odd parts of both magnitudes, their common power of 2 and the fraction's index in the block.
+         * @note All the fields are 64-bit, so a lane loads any of them with one (expand) load.
+        */
+        struct GcdQueue
+        {
+            alignas(FractionArray::alignment) std::uint64_t odd1[block_size];
+            alignas(FractionArray::alignment) std::uint64_t odd2[block_size];
+            alignas(FractionArray::alignment) std::uint64_t shift[block_size];
+            alignas(FractionArray::alignment) std::uint64_t index[block_size];
+            std::size_t count = 0;
+            std::size_t next = 0;
+        };
+
+        /*
+         * @brief The memory copy of 4 gcd lanes of the AVX2 kernel (which refills lanes through memory).
+        */
+        struct GcdLanes
+        {
+            alignas(32) std::uint64_t odd1[4];
+            alignas(32) std::uint64_t odd2[4];
+            std::uint64_t shift[4];
+            std::uint64_t index[4];
+        };
+
+        /*
+         * @brief The operands of a block (pointers to the first fraction of the block).
+        */
+        struct BlockOperands
+        {
+            const int* num1;
+            const int* den1;
+            const int* num2;
+            const int* den2;
+            std::size_t count;
+        };
+
+        // Scalar kernels
+
+        /*
+         * @brief Runs an operation with the Fraction operators.
+        */
+        Fraction apply(Op operation, const Fraction& num1, const Fraction& num2) {
+            switch (operation)
+            {
+                case Op::Add:
+                    return num1 + num2;
+
+                case Op::Sub:
+                    return num1 - num2;
+
+                case Op::Mul:
+                    return num1 * num2;
+
+                default:
+                    return num1 / num2;
+            }
+        }
+
+        /*
+         * @brief Computes the unreduced results of a range of a block (a SIMD kernel's tail).
+         * @note The products of two ints always fit in 64 bits, so do their sums.
+        */
+        template <Op operation>
+        void products_scalar(const BlockOperands& ops, WideBlock& wide, std::size_t first) {
+            for (std::size_t i = first; i < ops.count; i++)
+            {
+                const std::int64_t num1 = ops.num1[i], den1 = ops.den1[i], num2 = ops.num2[i], den2 = ops.den2[i];
+
+                if constexpr (operation == Op::Add)
+                    wide.numerators[i] = num1 * den2 + num2 * den1;
+
+                else if constexpr (operation == Op::Sub)
+                    wide.numerators[i] = num1 * den2 - num2 * den1;
+
+                else if constexpr (operation == Op::Mul)
+                    wide.numerators[i] = num1 * num2;
+
+                else
+                    wide.numerators[i] = num1 * den2;
+
+                wide.denominators[i] = (operation == Op::Div) ? den1 * num2 : den1 * den2;
+            }
+        }
+
+        /*
+         * @brief Three-way compares a range of a block (a SIMD kernel's tail).
+        */
+        void compare_scalar(const BlockOperands& ops, std::int8_t* result, std::size_t first) {
+            for (std::size_t i = first; i < ops.count; i++)
+            {
+                const std::int64_t lhs = std::int64_t{ops.num1[i]} * ops.den2[i];
+                const std::int64_t rhs = std::int64_t{ops.num2[i]} * ops.den1[i];
+                result[i] = static_cast<std::int8_t>((lhs > rhs) - (lhs < rhs));
+            }
+        }
+
+        // Lane-parallel gcd (the scalar parts)
+
+        /*
+         * @brief Gets the magnitude of a 64-bit number.
+        */
+        std::uint64_t magnitude(std::int64_t num) {
+            return (num < 0) ? 0ULL - static_cast<std::uint64_t>(num) : static_cast<std::uint64_t>(num);
+        }
+
+        /*
+         * @brief Stores the trivial gcds of a block and queues the others for the binary gcd loop.
+         * @note A zero denominator gets 0, a zero numerator gets the denominator and a part of magnitude 1 gets 1.
+        */
+        void queue_gcds(WideBlock& wide, std::size_t count, GcdQueue& queue) {
+            queue.count = queue.next = 0;
+
+            for (std::size_t i = 0; i < count; i++)
+            {
+                const std::uint64_t num = magnitude(wide.numerators[i]), den = magnitude(wide.denominators[i]);
+
+                if (num == 0 || den == 0)
+                    wide.divisors[i] = den;
+
+                else if (num == 1 || den == 1)
+                    wide.divisors[i] = 1;
+
+                else
+                {
+                    const std::size_t slot = queue.count++;
+                    queue.odd1[slot] = num >> std::countr_zero(num);
+                    queue.odd2[slot] = den >> std::countr_zero(den);
+                    queue.shift[slot] = static_cast<std::uint64_t>(std::countr_zero(num | den));
+                    queue.index[slot] = i;
+                }
+            }
+        }
+
+        /*
+         * @brief Stores the gcds of the finished lanes and refills them from the queue (through memory).
+         * @param done The finished lanes (a bit per lane, inactive lanes included).
+         * @param active The lanes that hold a fraction (updated).
+         * @note A lane left without a fraction keeps two equal numbers, so the steps don't change it.
+        */
+        void refill_lanes(WideBlock& wide, GcdQueue& queue, GcdLanes& lanes, unsigned done, unsigned& active) {
+            for (; done != 0; done &= done - 1)
+            {
+                const auto lane = static_cast<unsigned>(std::countr_zero(done));
+
+                if ((active & (1U << lane)) != 0)
+                    wide.divisors[lanes.index[lane]] = lanes.odd1[lane] << lanes.shift[lane];
+
+                if (queue.next == queue.count)
+                {
+                    active &= ~(1U << lane);
+                    continue;
+                }
+
+                lanes.odd1[lane] = queue.odd1[queue.next];
+                lanes.odd2[lane] = queue.odd2[queue.next];
+                lanes.shift[lane] = queue.shift[queue.next];
+                lanes.index[lane] = queue.index[queue.next];
+                queue.next++;
+                active |= 1U << lane;
+            }
+        }
+
+#ifdef ARIEL_FRACTION_ARRAY_X86
+        // AVX2 kernels
+
+        /*
+         * @brief Loads 4 ints sign-extended to 64-bit lanes.
+        */
+        __attribute__((target("avx2"))) inline __m256i load4(const int* source) {
+            return _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source)));
+        }
+
+        /*
+         * @brief Computes the unreduced results of a block, 4 fractions at a time.
+         * @note _mm256_mul_epi32 multiplies the signed low halves of the 64-bit lanes into full 64-bit products.
+        */
+        template <Op operation>
+        __attribute__((target("avx2"))) void products_avx2(const BlockOperands& ops, WideBlock& wide) {
+            std::size_t i = 0;
+
+            for (; i + 4 <= ops.count; i += 4)
+            {
+                const __m256i num1 = load4(ops.num1 + i), den1 = load4(ops.den1 + i), num2 = load4(ops.num2 + i), den2 = load4(ops.den2 + i);
+                __m256i numerator, denominator;
+
+                if constexpr (operation == Op::Add)
+                    numerator = _mm256_add_epi64(_mm256_mul_epi32(num1, den2), _mm256_mul_epi32(num2, den1));
+
+                else if constexpr (operation == Op::Sub)
+                    numerator = _mm256_sub_epi64(_mm256_mul_epi32(num1, den2), _mm256_mul_epi32(num2, den1));
+
+                else if constexpr (operation == Op::Mul)
+                    numerator = _mm256_mul_epi32(num1, num2);
+
+                else
+                    numerator = _mm256_mul_epi32(num1, den2);
+
+                if constexpr (operation == Op::Div)
+                    denominator = _mm256_mul_epi32(den1, num2);
+
+                else
+                    denominator = _mm256_mul_epi32(den1, den2);
+
+                _mm256_store_si256(reinterpret_cast<__m256i*>(wide.numerators + i), numerator);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(wide.denominators + i), denominator);
+            }
+
+            products_scalar<operation>(ops, wide, i);
+        }
+
+        /*
+         * @brief Three-way compares a block, 4 fractions at a time.
+        */
+        __attribute__((target("avx2"))) void compare_avx2(const BlockOperands& ops, std::int8_t* result) {
+            const __m256i even_lanes = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+            std::size_t i = 0;
+
+            for (; i + 4 <= ops.count; i += 4)
+            {
+                const __m256i lhs = _mm256_mul_epi32(load4(ops.num1 + i), load4(ops.den2 + i));
+                const __m256i rhs = _mm256_mul_epi32(load4(ops.num2 + i), load4(ops.den1 + i));
+
+                // (lhs < rhs) - (lhs > rhs) on all-ones masks is (lhs > rhs) - (lhs < rhs) on booleans.
+                const __m256i sign = _mm256_sub_epi64(_mm256_cmpgt_epi64(rhs, lhs), _mm256_cmpgt_epi64(lhs, rhs));
+                const __m128i packed32 = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(sign, even_lanes));
+                const __m128i packed16 = _mm_packs_epi32(packed32, packed32);
+                const int packed8 = _mm_cvtsi128_si32(_mm_packs_epi16(packed16, packed16));
+                std::memcpy(result + i, &packed8, sizeof(packed8));
+            }
+
+            compare_scalar(ops, result, i);
+        }
+
+        /*
+         * @brief Counts the trailing zeros of 4 non-zero 64-bit lanes.
+         * @note AVX2 has no vector count trailing zeros: the lowest set bit of each 32-bit half is converted to float,
+         *       and its exponent is the bit's position. A zero half gets a negative position and loses the max.
+        */
+        __attribute__((target("avx2"))) inline __m256i ctz4(__m256i num) {
+            const __m256i lowest = _mm256_and_si256(num, _mm256_sub_epi64(_mm256_setzero_si256(), num));
+            const __m256i exponents = _mm256_and_si256(_mm256_srli_epi32(_mm256_castps_si256(_mm256_cvtepi32_ps(lowest)), 23), _mm256_set1_epi32(0xFF));
+            const __m256i positions = _mm256_add_epi32(exponents, _mm256_setr_epi32(-127, -95, -127, -95, -127, -95, -127, -95));
+            const __m256i larger = _mm256_max_epi32(positions, _mm256_shuffle_epi32(positions, 0xB1));
+            return _mm256_and_si256(larger, _mm256_set1_epi64x(0xFFFFFFFF));
+        }
+
+        /*
+         * @brief A step of Stein's binary algorithm on 4 lanes of odd numbers: the smaller number stays and the other one
+         *        becomes the odd part of their difference. Finished lanes (equal numbers) don't change.
+         * @note The numbers are below 2^63, so the signed 64-bit comparison orders them.
+        */
+        __attribute__((target("avx2"))) inline void gcd_step4(__m256i& odd1, __m256i& odd2) {
+            const __m256i greater = _mm256_cmpgt_epi64(odd1, odd2);
+            const __m256i equal = _mm256_cmpeq_epi64(odd1, odd2);
+            const __m256i smaller = _mm256_blendv_epi8(odd1, odd2, greater);
+            const __m256i diff = _mm256_sub_epi64(_mm256_blendv_epi8(odd2, odd1, greater), smaller);
+            odd2 = _mm256_blendv_epi8(_mm256_srlv_epi64(diff, ctz4(diff)), odd2, equal);
+            odd1 = smaller;
+        }
+
+        /*
+         * @brief Refills the finished lanes of 4 AVX2 gcd lanes.
+        */
+        __attribute__((target("avx2"))) inline void refill4(WideBlock& wide, GcdQueue& queue, GcdLanes& lanes, __m256i& odd1, __m256i& odd2, unsigned& active) {
+            const auto done = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(odd1, odd2))));
+
+            if ((done & active) == 0 && active != 0)
+                return;
+
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes.odd1), odd1);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes.odd2), odd2);
+            refill_lanes(wide, queue, lanes, done, active);
+            odd1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes.odd1));
+            odd2 = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes.odd2));
+        }
+
+        /*
+         * @brief Calculates the queued gcds of a block with Stein's binary algorithm, in two independent groups of 4 lanes.
+         * @note Lanes finish after different numbers of steps: a finished lane is stored and refilled with the next queued
+         *       fraction while the others keep going, so no lane waits for the slowest one (only the queue's tail does).
+         * @note Finished lanes don't change, so they are checked every 8 steps, and the two groups hide each other's latency.
+        */
+        __attribute__((target("avx2"))) void gcd_avx2(WideBlock& wide, GcdQueue& queue) {
+            GcdLanes lanes1{}, lanes2{};
+            __m256i odd11 = _mm256_setzero_si256(), odd12 = odd11, odd21 = odd11, odd22 = odd11;
+            unsigned active1 = 0, active2 = 0;
+            refill4(wide, queue, lanes1, odd11, odd12, active1);
+            refill4(wide, queue, lanes2, odd21, odd22, active2);
+
+            while ((active1 | active2) != 0)
+            {
+                for (int step = 0; step < 8; step++)
+                {
+                    gcd_step4(odd11, odd12);
+                    gcd_step4(odd21, odd22);
+                }
+
+                refill4(wide, queue, lanes1, odd11, odd12, active1);
+                refill4(wide, queue, lanes2, odd21, odd22, active2);
+            }
+        }
+
+        // AVX-512 kernels
+
+        /*
+         * @brief Loads 8 ints sign-extended to 64-bit lanes.
+        */
+        __attribute__((target("avx512f"))) inline __m512i load8(const int* source) {
+            return _mm512_cvtepi32_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source)));
+        }
+
+        /*
+         * @brief Computes the unreduced results of a block, 8 fractions at a time.
+        */
+        template <Op operation>
+        __attribute__((target("avx512f"))) void products_avx512(const BlockOperands& ops, WideBlock& wide) {
+            std::size_t i = 0;
+
+            for (; i + 8 <= ops.count; i += 8)
+            {
+                const __m512i num1 = load8(ops.num1 + i), den1 = load8(ops.den1 + i), num2 = load8(ops.num2 + i), den2 = load8(ops.den2 + i);
+                __m512i numerator, denominator;
+
+                if constexpr (operation == Op::Add)
+                    numerator = _mm512_add_epi64(_mm512_mul_epi32(num1, den2), _mm512_mul_epi32(num2, den1));
+
+                else if constexpr (operation == Op::Sub)
+                    numerator = _mm512_sub_epi64(_mm512_mul_epi32(num1, den2), _mm512_mul_epi32(num2, den1));
+
+                else if constexpr (operation == Op::Mul)
+                    numerator = _mm512_mul_epi32(num1, num2);
+
+                else
+                    numerator = _mm512_mul_epi32(num1, den2);
+
+                if constexpr (operation == Op::Div)
+                    denominator = _mm512_mul_epi32(den1, num2);
+
+                else
+                    denominator = _mm512_mul_epi32(den1, den2);
+
+                _mm512_store_si512(wide.numerators + i, numerator);
+                _mm512_store_si512(wide.denominators + i, denominator);
+            }
+
+            products_scalar<operation>(ops, wide, i);
+        }
+
+        /*
+         * @brief Three-way compares a block, 8 fractions at a time.
+        */
+        __attribute__((target("avx512f"))) void compare_avx512(const BlockOperands& ops, std::int8_t* result) {
+            std::size_t i = 0;
+
+            for (; i + 8 <= ops.count; i += 8)
+            {
+                const __m512i lhs = _mm512_mul_epi32(load8(ops.num1 + i), load8(ops.den2 + i));
+                const __m512i rhs = _mm512_mul_epi32(load8(ops.num2 + i), load8(ops.den1 + i));
+                const __m512i greater = _mm512_maskz_set1_epi64(_mm512_cmpgt_epi64_mask(lhs, rhs), 1);
+                const __m512i sign = _mm512_mask_set1_epi64(greater, _mm512_cmplt_epi64_mask(lhs, rhs), -1);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(result + i), _mm512_cvtepi64_epi8(sign));
+            }
+
+            compare_scalar(ops, result, i);
+        }
+
+        /*
+         * @brief A step of Stein's binary algorithm on 8 lanes of odd numbers, like gcd_step4().
+         * @note The trailing zeros are counted with AVX512CD: 63 - lzcnt(lowest set bit).
+        */
+        __attribute__((target("avx512f,avx512cd"))) inline void gcd_step8(__m512i& odd1, __m512i& odd2) {
+            const __mmask8 unequal = _mm512_cmpneq_epu64_mask(odd1, odd2);
+            const __m512i diff = _mm512_abs_epi64(_mm512_sub_epi64(odd1, odd2));
+            const __m512i lowest = _mm512_and_si512(diff, _mm512_sub_epi64(_mm512_setzero_si512(), diff));
+            odd1 = _mm512_min_epu64(odd1, odd2);
+            odd2 = _mm512_mask_srlv_epi64(odd2, unequal, diff, _mm512_sub_epi64(_mm512_set1_epi64(63), _mm512_lzcnt_epi64(lowest)));
+        }
+
+        /*
+         * @brief Refills the finished lanes of 8 AVX-512 gcd lanes: the gcds are stored to the block
+         *        and the next queued fractions are expand-loaded into the finished lanes (no reload through memory).
+        */
+        __attribute__((target("avx512f,avx512cd"))) inline void refill8(WideBlock& wide, GcdQueue& queue, __m512i& odd1, __m512i& odd2,
+                                                                         __m512i& shift, __m512i& index, __mmask8& active) {
+            const __mmask8 done = _mm512_cmpeq_epu64_mask(odd1, odd2);
+
+            if ((done & active) == 0 && active != 0)
+                return;
+
+            alignas(FractionArray::alignment) std::uint64_t gcds[8], indices[8];
+            _mm512_store_si512(gcds, _mm512_sllv_epi64(odd1, shift));
+            _mm512_store_si512(indices, index);
+
+            for (unsigned finished = done & active; finished != 0; finished &= finished - 1)
+            {
+                const auto lane = static_cast<unsigned>(std::countr_zero(finished));
+                wide.divisors[indices[lane]] = gcds[lane];
+            }
+
+            // The last lanes of a block may outnumber the queued fractions.
+            unsigned take = done;
+            const std::size_t available = queue.count - queue.next;
+
+            while (static_cast<std::size_t>(std::popcount(take)) > available)
+                take &= take - 1;
+
+            const auto loaded = static_cast<__mmask8>(take);
+            odd1 = _mm512_mask_expandloadu_epi64(odd1, loaded, queue.odd1 + queue.next);
+            odd2 = _mm512_mask_expandloadu_epi64(odd2, loaded, queue.odd2 + queue.next);
+            shift = _mm512_mask_expandloadu_epi64(shift, loaded, queue.shift + queue.next);
+            index = _mm512_mask_expandloadu_epi64(index, loaded, queue.index + queue.next);
+            queue.next += static_cast<std::size_t>(std::popcount(take));
+            active = static_cast<__mmask8>((active & ~done) | loaded);
+        }
+
+        /*
+         * @brief Calculates the queued gcds of a block with Stein's binary algorithm, in two independent groups of 8 lanes.
+         * @note Lanes are refilled and checked like in gcd_avx2(), but the refilled lanes don't go through memory.
+        */
+        __attribute__((target("avx512f,avx512cd"))) void gcd_avx512(WideBlock& wide, GcdQueue& queue) {
+            __m512i odd11 = _mm512_setzero_si512(), odd12 = odd11, shift1 = odd11, index1 = odd11;
+            __m512i odd21 = odd11, odd22 = odd11, shift2 = odd11, index2 = odd11;
+            __mmask8 active1 = 0, active2 = 0;
+            refill8(wide, queue, odd11, odd12, shift1, index1, active1);
+            refill8(wide, queue, odd21, odd22, shift2, index2, active2);
+
+            while ((active1 | active2) != 0)
+            {
+                for (int step = 0; step < 8; step++)
+                {
+                    gcd_step8(odd11, odd12);
+                    gcd_step8(odd21, odd22);
+                }
+
+                refill8(wide, queue, odd11, odd12, shift1, index1, active1);
+                refill8(wide, queue, odd21, odd22, shift2, index2, active2);
+            }
+        }
+#endif
+
+        // Dispatch
+
+        /*
+         * @brief Computes the unreduced results of a block with an instruction set.
+        */
+        template <Op operation>
+        void products(FractionArray::Isa isa, const BlockOperands& ops, WideBlock& wide) {
+#ifdef ARIEL_FRACTION_ARRAY_X86
+            if (isa == FractionArray::Isa::AVX512)
+                return products_avx512<operation>(ops, wide);
+
+            if (isa == FractionArray::Isa::AVX2)
+                return products_avx2<operation>(ops, wide);
+#endif
+            (void)isa;
+            products_scalar<operation>(ops, wide, 0);
+        }
+
+        /*
+         * @brief Calculates the gcds of a block with an instruction set.
+        */
+        void gcds(FractionArray::Isa isa, WideBlock& wide, std::size_t count) {
+            GcdQueue queue;
+            queue_gcds(wide, count, queue);
+
+#ifdef ARIEL_FRACTION_ARRAY_X86
+            if (isa == FractionArray::Isa::AVX512)
+                return gcd_avx512(wide, queue);
+
+            if (isa == FractionArray::Isa::AVX2)
+                return gcd_avx2(wide, queue);
+#endif
+            (void)isa;
+
+            for (std::size_t i = 0; i < queue.count; i++)
+            {
+                const std::size_t index = queue.index[i];
+                wide.divisors[index] = gcd::gcd(magnitude(wide.numerators[index]), magnitude(wide.denominators[index]));
+            }
+        }
+
+        /*
+         * @brief Divides a 64-bit fraction by the gcd of its parts, normalizes the sign and narrows it to int.
+         * @param divisor The gcd of the parts (0 for a zero denominator).
+         * @return True if the reduced fraction fits in int, false on overflow or a zero denominator.
+        */
+        bool narrow(std::int64_t numerator, std::int64_t denominator, std::uint64_t divisor, int& out_numerator, int& out_denominator) {
+            if (divisor == 0)
+                return false;
+
+            if (denominator < 0)
+            {
+                numerator = -numerator;
+                denominator = -denominator;
+            }
+
+            if (divisor != 1)
+            {
+                numerator /= static_cast<std::int64_t>(divisor);
+                denominator /= static_cast<std::int64_t>(divisor);
+            }
+
+            if (numerator < std::numeric_limits<int>::min() || numerator > std::numeric_limits<int>::max() || denominator > std::numeric_limits<int>::max())
+                return false;
+
+            out_numerator = static_cast<int>(numerator);
+            out_denominator = static_cast<int>(denominator);
+            return true;
+        }
+
+        /*
+         * @brief Runs an arithmetic operation on all the blocks.
+        */
+        template <Op operation>
+        void arithmetic(FractionArray::Isa isa, std::span<const int> num1, std::span<const int> den1, std::span<const int> num2,
+                        std::span<const int> den2, int* out_num, int* out_den) {
+            WideBlock wide;
+
+            for (std::size_t start = 0; start < num1.size(); start += block_size)
+            {
+                const BlockOperands ops{num1.data() + start, den1.data() + start, num2.data() + start, den2.data() + start,
+                                        std::min(block_size, num1.size() - start)};
+                products<operation>(isa, ops, wide);
+                gcds(isa, wide, ops.count);
+
+                for (std::size_t i = 0; i < ops.count; i++)
+                {
+                    // The scalar operator throws the same exception for an overflow or a division by zero.
+                    if (!narrow(wide.numerators[i], wide.denominators[i], wide.divisors[i], out_num[start + i], out_den[start + i]))
+                    {
+                        const Fraction result = apply(operation, Fraction(ops.num1[i], ops.den1[i]), Fraction(ops.num2[i], ops.den2[i]));
+                        out_num[start + i] = result.getNumerator();
+                        out_den[start + i] = result.getDenominator();
+                    }
+                }
+            }
+        }
+
+        /*
+         * @brief Detects the best instruction set of the CPU.
+         * @note AVX2 is never the default: its 4-lane gcd emulates count trailing zeros and refills lanes through memory,
+         *       so the batch normalization is no faster than the scalar gcd (it stays selectable with set_isa()).
+        */
+        FractionArray::Isa detect_isa() {
+#ifdef ARIEL_FRACTION_ARRAY_X86
+            __builtin_cpu_init();
+
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512cd"))
+                return FractionArray::Isa::AVX512;
+#endif
+            return FractionArray::Isa::Scalar;
+        }
+
+        /*
+         * @brief The best instruction set of the CPU (detected once).
+        */
+        FractionArray::Isa best_isa() {
+            static const FractionArray::Isa isa = detect_isa();
+            return isa;
+        }
+
+        /*
+         * @brief The selected instruction set.
+        */
+        FractionArray::Isa& selected_isa() {
+            static FractionArray::Isa isa = best_isa();
+            return isa;
+        }
+    }
+
+    // Construction and storage
+
+    FractionArray::FractionArray(std::size_t count) : _numerators(count, 0), _denominators(count, 1) {}
+
+    FractionArray::FractionArray(std::span<const Fraction> fractions) : _numerators(fractions.size()), _denominators(fractions.size()) {
+        for (std::size_t i = 0; i < fractions.size(); i++)
+            set(i, fractions[i]);
+    }
+
+    FractionArray FractionArray::from_parts(std::span<const int> numerators, std::span<const int> denominators) {
+        if (numerators.size() != denominators.size())
+            ARIEL_FRACTION_THROW(std::invalid_argument("Numerator and denominator arrays must have the same length"));
+
+        FractionArray result(numerators.size());
+        const Isa isa = FractionArray::isa();
+
+        if (isa == Isa::Scalar)
+        {
+            for (std::size_t i = 0; i < result.size(); i++)
+                result.set(i, Fraction(numerators[i], denominators[i]));
+
+            return result;
+        }
+
+        WideBlock wide;
+
+        for (std::size_t start = 0; start < numerators.size(); start += block_size)
+        {
+            const std::size_t count = std::min(block_size, numerators.size() - start);
+            std::copy_n(numerators.data() + start, count, wide.numerators);
+            std::copy_n(denominators.data() + start, count, wide.denominators);
+            gcds(isa, wide, count);
+
+            for (std::size_t i = 0; i < count; i++)
+            {
+                // Zero denominators and fractions that don't fit in int fall back to the constructor, which throws.
+                if (!narrow(wide.numerators[i], wide.denominators[i], wide.divisors[i], result._numerators[start + i], result._denominators[start + i]))
+                    result.set(start + i, Fraction(numerators[start + i], denominators[start + i]));
+            }
+        }
+
+        return result;
+    }
+
+    void FractionArray::resize(std::size_t count) {
+        _numerators.resize(count, 0);
+        _denominators.resize(count, 1);
+    }
+
+    void FractionArray::push_back(const Fraction& fraction) {
+        _numerators.push_back(fraction.getNumerator());
+        _denominators.push_back(fraction.getDenominator());
+    }
+
+    std::vector<Fraction> FractionArray::to_vector() const {
+        std::vector<Fraction> fractions;
+        fractions.reserve(size());
+
+        for (std::size_t i = 0; i < size(); i++)
+            fractions.push_back((*this)[i]);
+
+        return fractions;
+    }
+
+    // Batch operations
+
+    void FractionArray::_arithmetic(detail::FractionArrayOp operation, const FractionArray& num1, const FractionArray& num2, FractionArray& result) {
+        if (num1.size() != num2.size())
+            ARIEL_FRACTION_THROW(std::invalid_argument("Fraction arrays must have the same length"));
+
+        // The operands may alias the result: each block is read before it is written.
+        const std::span<const int> num1_num = num1.numerators(), num1_den = num1.denominators();
+        const std::span<const int> num2_num = num2.numerators(), num2_den = num2.denominators();
+        result.resize(num1.size());
+        const Isa isa = FractionArray::isa();
+
+        if (isa == Isa::Scalar)
+        {
+            for (std::size_t i = 0; i < result.size(); i++)
+                result.set(i, apply(operation, Fraction(num1_num[i], num1_den[i], Fraction::_reduced_tag{}),
+                                    Fraction(num2_num[i], num2_den[i], Fraction::_reduced_tag{})));
+
+            return;
+        }
+
+        int* out_num = result._numerators.data();
+        int* out_den = result._denominators.data();
+
+        switch (operation)
+        {
+            case Op::Add:
+                arithmetic<Op::Add>(isa, num1_num, num1_den, num2_num, num2_den, out_num, out_den);
+                break;
+
+            case Op::Sub:
+                arithmetic<Op::Sub>(isa, num1_num, num1_den, num2_num, num2_den, out_num, out_den);
+                break;
+
+            case Op::Mul:
+                arithmetic<Op::Mul>(isa, num1_num, num1_den, num2_num, num2_den, out_num, out_den);
+                break;
+
+            default:
+                arithmetic<Op::Div>(isa, num1_num, num1_den, num2_num, num2_den, out_num, out_den);
+                break;
+        }
+    }
+
+    void FractionArray::add(const FractionArray& num1, const FractionArray& num2, FractionArray& result) {
+        _arithmetic(Op::Add, num1, num2, result);
+    }
+
+    void FractionArray::sub(const FractionArray& num1, const FractionArray& num2, FractionArray& result) {
+        _arithmetic(Op::Sub, num1, num2, result);
+    }
+
+    void FractionArray::mul(const FractionArray& num1, const FractionArray& num2, FractionArray& result) {
+        _arithmetic(Op::Mul, num1, num2, result);
+    }
+
+    void FractionArray::div(const FractionArray& num1, const FractionArray& num2, FractionArray& result) {
+        _arithmetic(Op::Div, num1, num2, result);
+    }
+
+    void FractionArray::compare(const FractionArray& num1, const FractionArray& num2, std::span<std::int8_t> result) {
+        if (num1.size() != num2.size() || result.size() < num1.size())
+            ARIEL_FRACTION_THROW(std::invalid_argument("Fraction arrays must have the same length"));
+
+        const Isa isa = FractionArray::isa();
+
+        for (std::size_t start = 0; start < num1.size(); start += block_size)
+        {
+            const BlockOperands ops{num1._numerators.data() + start, num1._denominators.data() + start, num2._numerators.data() + start,
+                                    num2._denominators.data() + start, std::min(block_size, num1.size() - start)};
+
+#ifdef ARIEL_FRACTION_ARRAY_X86
+            if (isa == Isa::AVX512)
+            {
+                compare_avx512(ops, result.data() + start);
+                continue;
+            }
+
+            if (isa == Isa::AVX2)
+            {
+                compare_avx2(ops, result.data() + start);
+                continue;
+            }
+#endif
+            // The cross products of ints can't overflow, so the scalar kernel is exactly Fraction's <=>.
+            compare_scalar(ops, result.data() + start, 0);
+        }
+    }
+
+    FractionArray operator+(const FractionArray& num1, const FractionArray& num2) {
+        FractionArray result;
+        FractionArray::add(num1, num2, result);
+        return result;
+    }
+
+    FractionArray operator-(const FractionArray& num1, const FractionArray& num2) {
+        FractionArray result;
+        FractionArray::sub(num1, num2, result);
+        return result;
+    }
+
+    FractionArray operator*(const FractionArray& num1, const FractionArray& num2) {
+        FractionArray result;
+        FractionArray::mul(num1, num2, result);
+        return result;
+    }
+
+    FractionArray operator/(const FractionArray& num1, const FractionArray& num2) {
+        FractionArray result;
+        FractionArray::div(num1, num2, result);
+        return result;
+    }
+
+    // Stream operators
+
+    std::istream& operator>>(std::istream& inptstream, FractionArray& fractions) {
+        std::vector<int> numerators, denominators;
+        int numitor = 0, denitor = 0;
+
+        while (inptstream >> numitor)
+        {
+            if (!(inptstream >> denitor))
+                ARIEL_FRACTION_THROW(std::runtime_error("Invalid input"));
+
+            if (denitor == 0)
+                ARIEL_FRACTION_THROW(std::runtime_error("Denominator can't be zero"));
+
+            numerators.push_back(numitor);
+            denominators.push_back(denitor);
+        }
+
+        if (!inptstream.eof())
+            ARIEL_FRACTION_THROW(std::runtime_error("Invalid input"));
+
+        fractions = FractionArray::from_parts(numerators, denominators);
+        return inptstream;
+    }
+
+    // Instruction set dispatch
+
+    FractionArray::Isa FractionArray::isa() {
+        return selected_isa();
+    }
+
+    bool FractionArray::supports(Isa isa) {
+        return static_cast<int>(isa) <= static_cast<int>(best_isa());
+    }
+
+    void FractionArray::set_isa(Isa isa) {
+        if (!supports(isa))
+            ARIEL_FRACTION_THROW(std::invalid_argument("The CPU doesn't support this instruction set"));
+
+        selected_isa() = isa;
+    }
+}
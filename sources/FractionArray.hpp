@@ -0,0 +1,319 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <new>
+#include <span>
+#include <vector>
+#include "Fraction.hpp"
+
+namespace ariel
+{
+    namespace detail
+    {
+        /*
+         * @brief A minimal allocator of over-aligned memory.
+         * @note Alignment must be a power of 2, at least alignof(T).
+        */
+        template <typename T, std::size_t Alignment>
+        struct AlignedAllocator
+        {
+            using value_type = T;
+
+            template <typename U>
+            struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+            AlignedAllocator() noexcept = default;
+
+            template <typename U>
+            AlignedAllocator(const AlignedAllocator<U, Alignment>& /*unused*/) noexcept {}
+
+            T* allocate(std::size_t count) {
+                return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{Alignment}));
+            }
+
+            void deallocate(T* pointer, std::size_t /*count*/) noexcept {
+                ::operator delete(pointer, std::align_val_t{Alignment});
+            }
+
+            template <typename U>
+            bool operator==(const AlignedAllocator<U, Alignment>& /*unused*/) const noexcept { return true; }
+        };
+
+        /*
+         * @brief The element-wise operations of FractionArray.
+        */
+        enum class FractionArrayOp { Add, Sub, Mul, Div };
+    }
+
+    /*
+     * @brief An array of int fractions stored as a structure of arrays: the numerators and the denominators
+     *        are in two separate 64-byte aligned arrays, and the element-wise operations run in batches.
+     * @note Every element is a normalized fraction, like a Fraction (reduced, with a positive denominator).
+     * @note The arithmetic kernels compute the unreduced 64-bit products and sums of a block with AVX2 or AVX-512,
+     *       then reduce them with a lane-parallel binary gcd. The comparison kernels need no reduction.
+     * @note The instruction set is detected once at runtime (CPUID), see isa(): AVX-512 if the CPU has it, else scalar
+     *       (the AVX2 kernels are only selected with set_isa()). The scalar kernels use the Fraction operators
+     *       themselves, and every kernel gives exactly their results: the same reduced parts,
+     *       and the same exception for the first element that overflows or divides by zero
+     *       (the result array is then partially written).
+    */
+    class FractionArray
+    {
+        public:
+            /*
+             * @brief The instruction sets of the batch kernels.
+            */
+            enum class Isa { Scalar, AVX2, AVX512 };
+
+            /*
+             * @brief The alignment of the numerator and denominator arrays (a cache line, and an AVX-512 register).
+            */
+            static constexpr std::size_t alignment = 64;
+
+        private:
+            /*
+             * @brief The storage of the numerators and the denominators.
+            */
+            using _Storage = std::vector<int, detail::AlignedAllocator<int, alignment>>;
+
+            /*
+             * @brief The numerators.
+            */
+            _Storage _numerators;
+
+            /*
+             * @brief The denominators (always positive).
+            */
+            _Storage _denominators;
+
+            /*
+             * @brief Runs an element-wise arithmetic operation.
+             * @param operation The operation.
+             * @param num1 The left operands.
+             * @param num2 The right operands (of the same length).
+             * @param result The results (output, may be one of the operands).
+             * @throw invalid_argument if the operands have different lengths.
+             * @throw overflow_error or runtime_error like the scalar operator, for the first failing element.
+             * @note This function is static because it doesn't require an instance of the class.
+            */
+            static void _arithmetic(detail::FractionArrayOp operation, const FractionArray& num1, const FractionArray& num2, FractionArray& result);
+
+        public:
+            /*
+             * @brief Default constructor of the FractionArray class.
+             * @note The default array is empty.
+            */
+            FractionArray() = default;
+
+            /*
+             * @brief Construct a new FractionArray object of zeros.
+             * @param count The number of fractions.
+            */
+            explicit FractionArray(std::size_t count);
+
+            /*
+             * @brief Construct a new FractionArray object from fractions.
+             * @param fractions The fractions.
+            */
+            explicit FractionArray(std::span<const Fraction> fractions);
+
+            /*
+             * @brief Builds an array from unreduced parts, normalized in bulk (the gcds are calculated lanes in parallel).
+             * @param numerators The numerators.
+             * @param denominators The denominators (of the same length).
+             * @return FractionArray The fractions, each one exactly like Fraction(numerator, denominator).
+             * @throw invalid_argument if the lengths differ or a denominator is zero.
+             * @throw overflow_error if a reduced fraction doesn't fit in int (3 / INT_MIN).
+            */
+            static FractionArray from_parts(std::span<const int> numerators, std::span<const int> denominators);
+
+            /*
+             * @brief Gets the number of fractions.
+             * @return std::size_t The number of fractions.
+            */
+            std::size_t size() const { return _numerators.size(); }
+
+            /*
+             * @brief Checks if the array is empty.
+             * @return True if there are no fractions, false otherwise.
+            */
+            bool empty() const { return _numerators.empty(); }
+
+            /*
+             * @brief Changes the number of fractions, new fractions are zeros.
+             * @param count The number of fractions.
+            */
+            void resize(std::size_t count);
+
+            /*
+             * @brief Appends a fraction.
+             * @param fraction The fraction.
+            */
+            void push_back(const Fraction& fraction);
+
+            /*
+             * @brief Gets a fraction.
+             * @param index The index (must be less than size()).
+             * @return Fraction The fraction.
+            */
+            Fraction operator[](std::size_t index) const {
+                return Fraction(_numerators[index], _denominators[index], Fraction::_reduced_tag{});
+            }
+
+            /*
+             * @brief Sets a fraction.
+             * @param index The index (must be less than size()).
+             * @param fraction The fraction.
+            */
+            void set(std::size_t index, const Fraction& fraction) {
+                _numerators[index] = fraction.getNumerator();
+                _denominators[index] = fraction.getDenominator();
+            }
+
+            /*
+             * @brief Gets the numerators.
+             * @return std::span<const int> The numerators (64-byte aligned).
+            */
+            std::span<const int> numerators() const { return _numerators; }
+
+            /*
+             * @brief Gets the denominators.
+             * @return std::span<const int> The denominators (64-byte aligned).
+            */
+            std::span<const int> denominators() const { return _denominators; }
+
+            /*
+             * @brief Converts the array to a vector of fractions.
+             * @return std::vector<Fraction> The fractions.
+            */
+            std::vector<Fraction> to_vector() const;
+
+            /*
+             * @brief Adds two arrays element-wise.
+             * @param num1 The left operands.
+             * @param num2 The right operands (of the same length).
+             * @param result The sums (output, may be one of the operands).
+             * @throw invalid_argument if the operands have different lengths.
+             * @throw overflow_error if a sum doesn't fit.
+            */
+            static void add(const FractionArray& num1, const FractionArray& num2, FractionArray& result);
+
+            /*
+             * @brief Subtracts two arrays element-wise.
+             * @param num1 The left operands.
+             * @param num2 The right operands (of the same length).
+             * @param result The differences (output, may be one of the operands).
+             * @throw invalid_argument if the operands have different lengths.
+             * @throw overflow_error if a difference doesn't fit.
+            */
+            static void sub(const FractionArray& num1, const FractionArray& num2, FractionArray& result);
+
+            /*
+             * @brief Multiplies two arrays element-wise.
+             * @param num1 The left operands.
+             * @param num2 The right operands (of the same length).
+             * @param result The products (output, may be one of the operands).
+             * @throw invalid_argument if the operands have different lengths.
+             * @throw overflow_error if a product doesn't fit.
+            */
+            static void mul(const FractionArray& num1, const FractionArray& num2, FractionArray& result);
+
+            /*
+             * @brief Divides two arrays element-wise.
+             * @param num1 The left operands.
+             * @param num2 The right operands (of the same length).
+             * @param result The quotients (output, may be one of the operands).
+             * @throw invalid_argument if the operands have different lengths.
+             * @throw runtime_error if a divisor is zero.
+             * @throw overflow_error if a quotient doesn't fit.
+            */
+            static void div(const FractionArray& num1, const FractionArray& num2, FractionArray& result);
+
+            /*
+             * @brief Three-way compares two arrays element-wise.
+             * @param num1 The left operands.
+             * @param num2 The right operands (of the same length).
+             * @param result -1, 0 or 1 for less, equal or greater (output, at least as long as the operands).
+             * @throw invalid_argument if the lengths don't match.
+            */
+            static void compare(const FractionArray& num1, const FractionArray& num2, std::span<std::int8_t> result);
+
+            /*
+             * @brief Adds two arrays element-wise.
+             * @return FractionArray The sums.
+            */
+            friend FractionArray operator+(const FractionArray& num1, const FractionArray& num2);
+
+            /*
+             * @brief Subtracts two arrays element-wise.
+             * @return FractionArray The differences.
+            */
+            friend FractionArray operator-(const FractionArray& num1, const FractionArray& num2);
+
+            /*
+             * @brief Multiplies two arrays element-wise.
+             * @return FractionArray The products.
+            */
+            friend FractionArray operator*(const FractionArray& num1, const FractionArray& num2);
+
+            /*
+             * @brief Divides two arrays element-wise.
+             * @return FractionArray The quotients.
+            */
+            friend FractionArray operator/(const FractionArray& num1, const FractionArray& num2);
+
+            /*
+             * @brief Compares two arrays (all the fractions).
+            */
+            friend bool operator==(const FractionArray& num1, const FractionArray& num2) = default;
+
+            /*
+             * @brief Reads fractions (numerator and denominator pairs) until the end of the input stream,
+             *        then normalizes them in bulk.
+             * @return std::istream& The input stream.
+             * @throw runtime_error if the input is invalid or a denominator is zero (like reading a Fraction).
+             * @note The array is replaced only if every fraction was read.
+            */
+            friend std::istream& operator>>(std::istream& inptstream, FractionArray& fractions);
+
+            /*
+             * @brief Gets the instruction set of the batch kernels.
+             * @return Isa The instruction set, AVX-512 if the CPU supports it and scalar otherwise, unless set_isa() chose another.
+            */
+            static Isa isa();
+
+            /*
+             * @brief Checks if the CPU supports an instruction set.
+             * @param isa The instruction set.
+             * @return True if the kernels of the instruction set can run, false otherwise.
+            */
+            static bool supports(Isa isa);
+
+            /*
+             * @brief Selects the instruction set of the batch kernels (for tests and benchmarks).
+             * @param isa The instruction set.
+             * @throw invalid_argument if the CPU doesn't support it.
+             * @note Not thread safe: call it before running kernels on other threads.
+            */
+            static void set_isa(Isa isa);
+    };
+}
@@ -0,0 +1,315 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include "Fraction.hpp"
+#include "ThreadPool.hpp"
+
+namespace ariel
+{
+    /*
+     * @brief The ways the fraction comparators and sorts decide the order (both give the same order).
+     * @note Exact - the fractions' operator<=> (cross multiplication, overflow safe).
+     * @note Filtered - double approximations first, the exact comparison only when they are too close to decide.
+    */
+    enum class CompareMode { Exact, Filtered };
+
+    namespace detail
+    {
+        /*
+         * @brief The relative error bound of approximate(), twice the worst case so the filter's own roundings are covered.
+         * @note Parts of at most 53 bits convert to double exactly, so only the division rounds (2^-53).
+         *       Wider parts round too, and the three roundings stay below 4 * 2^-53.
+        */
+        template <typename IntT>
+        inline constexpr double approximation_error = (std::numeric_limits<IntT>::digits <= std::numeric_limits<double>::digits) ? 0x1p-52 : 0x1p-50;
+
+        /*
+         * @brief Approximates a fraction with a single division.
+         * @return double The approximation, within approximation_error<IntT> / 2 relative error.
+         * @note The parts are at most 2^127, so the quotient never overflows or becomes subnormal.
+        */
+        template <typename IntT, typename Policy>
+        constexpr double approximate(const BasicFraction<IntT, Policy>& fraction) {
+            return static_cast<double>(fraction.getNumerator()) / static_cast<double>(fraction.getDenominator());
+        }
+
+        /*
+         * @brief Compares two fractions through their approximations, exactly only when the approximations are too close.
+         * @param num1 The first fraction.
+         * @param approx1 The approximation of the first fraction (approximate(num1)).
+         * @param num2 The second fraction.
+         * @param approx2 The approximation of the second fraction (approximate(num2)).
+         * @return std::strong_ordering The exact ordering of num1 relative to num2.
+         * @note Each approximation is within a relative error of its fraction, so a gap larger than the sum
+         *       of both errors can't be closed by the exact values (and zero is always approximated exactly).
+        */
+        template <typename IntT, typename Policy>
+        constexpr std::strong_ordering filtered_compare(const BasicFraction<IntT, Policy>& num1, double approx1, const BasicFraction<IntT, Policy>& num2, double approx2) {
+            const double gap = approx1 - approx2;
+            const double bound = ((approx1 < 0 ? -approx1 : approx1) + (approx2 < 0 ? -approx2 : approx2)) * approximation_error<IntT>;
+
+            if (gap > bound)
+                return std::strong_ordering::greater;
+
+            if (gap < -bound)
+                return std::strong_ordering::less;
+
+            return num1 <=> num2;
+        }
+
+        /*
+         * @brief Checks if two sorted approximations are too close to order their fractions.
+         * @param lower The smaller approximation.
+         * @param upper The larger approximation.
+         * @note A misordered pair's approximations are within the filter's bound, and so are all the approximations
+         *       between them: each neighbour's gap is at most the pair's gap, and each neighbour's magnitude is at least
+         *       the smaller one's, so twice the error bound of the larger neighbour covers it.
+        */
+        template <typename IntT>
+        constexpr bool approximately_tied(double lower, double upper) {
+            const double larger = std::max(lower < 0 ? -lower : lower, upper < 0 ? -upper : upper);
+            return upper - lower <= larger * 2 * approximation_error<IntT>;
+        }
+
+        /*
+         * @brief Sorts keys that are sorted by their approximations exactly: only the runs of tied neighbours are sorted again.
+         * @param keys The keys, sorted by their approximations.
+        */
+        template <typename IntT, typename Policy, typename Key>
+        void refine_ties(std::span<Key> keys) {
+            std::size_t start = 0;
+
+            for (std::size_t i = 1; i <= keys.size(); i++)
+            {
+                if (i < keys.size() && approximately_tied<IntT>(keys[i - 1].approximation, keys[i].approximation))
+                    continue;
+
+                if (i - start > 1)
+                    std::sort(keys.begin() + static_cast<std::ptrdiff_t>(start), keys.begin() + static_cast<std::ptrdiff_t>(i),
+                              [](const Key& key1, const Key& key2) { return key1.fraction < key2.fraction; });
+
+                start = i;
+            }
+        }
+
+        /*
+         * @brief Maps a double to an unsigned key of the same order, for the radix sort.
+         * @note Non-negative numbers get the sign bit set, negative numbers are flipped entirely (larger magnitudes sort lower).
+        */
+        constexpr std::uint64_t radix_key(double value) {
+            const auto bits = std::bit_cast<std::uint64_t>(value);
+            return ((bits >> 63) != 0) ? ~bits : bits | (std::uint64_t{1} << 63);
+        }
+
+        /*
+         * @brief Frees storage allocated by ::operator new.
+        */
+        struct OperatorDelete
+        {
+            void operator()(void* pointer) const noexcept { ::operator delete(pointer); }
+        };
+
+        /*
+         * @brief The smallest range parallel_sort() radix sorts, smaller ones are sorted by sort().
+        */
+        inline constexpr std::size_t parallel_sort_threshold = std::size_t{1} << 14;
+    }
+
+    /*
+     * @brief A less-than comparator of fractions (for std::sort, std::map, range filters and so on).
+     * @note Filtered pays two divisions per comparison but rarely the exact one, it pays off for 128-bit
+     *       fractions whose exact comparison is slow. Sort with sort() to compute the approximations only once.
+    */
+    template <CompareMode Mode = CompareMode::Filtered>
+    struct FractionLess
+    {
+        template <typename IntT, typename Policy>
+        constexpr bool operator()(const BasicFraction<IntT, Policy>& num1, const BasicFraction<IntT, Policy>& num2) const {
+            if constexpr (Mode == CompareMode::Exact)
+                return num1 < num2;
+
+            else
+                return detail::filtered_compare(num1, detail::approximate(num1), num2, detail::approximate(num2)) < 0;
+        }
+    };
+
+    /*
+     * @brief A fraction with its cached approximation, the precomputed key of the filtered sort.
+    */
+    template <typename IntT, typename Policy = overflow::ThrowOnOverflow>
+    struct FilteredKey
+    {
+        /*
+         * @brief The approximation of the fraction.
+        */
+        double approximation = 0;
+
+        /*
+         * @brief The fraction.
+        */
+        BasicFraction<IntT, Policy> fraction;
+
+        FilteredKey() = default;
+
+        /*
+         * @brief Construct a new FilteredKey object.
+         * @param value The fraction.
+        */
+        constexpr explicit FilteredKey(const BasicFraction<IntT, Policy>& value): approximation(detail::approximate(value)), fraction(value) {}
+
+        /*
+         * @brief Compares two keys exactly (the approximations first).
+        */
+        friend constexpr bool operator<(const FilteredKey& key1, const FilteredKey& key2) {
+            return detail::filtered_compare(key1.fraction, key1.approximation, key2.fraction, key2.approximation) < 0;
+        }
+    };
+
+    /*
+     * @brief Sorts fractions in ascending order (not stable, equal fractions are identical anyway).
+     * @param fractions The fractions.
+     * @param mode Exact - std::sort with operator<.
+     *             Filtered - the fractions are approximated once into precomputed keys, sorted by the approximations alone,
+     *             then the runs of neighbours the approximations can't order are sorted exactly. The keys are copied back.
+    */
+    template <typename IntT, typename Policy>
+    void sort(std::span<BasicFraction<IntT, Policy>> fractions, CompareMode mode = CompareMode::Filtered) {
+        if (mode == CompareMode::Exact)
+        {
+            std::sort(fractions.begin(), fractions.end());
+            return;
+        }
+
+        using Key = FilteredKey<IntT, Policy>;
+        std::vector<Key> keys(fractions.begin(), fractions.end());
+        std::sort(keys.begin(), keys.end(), [](const Key& key1, const Key& key2) { return key1.approximation < key2.approximation; });
+        detail::refine_ties<IntT, Policy>(std::span<Key>(keys));
+        std::transform(keys.begin(), keys.end(), fractions.begin(), [](const FilteredKey<IntT, Policy>& key) { return key.fraction; });
+    }
+
+    /*
+     * @brief Sorts fractions in ascending order on a thread pool (not stable, equal fractions are identical anyway).
+     * @param fractions The fractions.
+     * @param pool The thread pool, each of its threads gets an equal share of the fractions.
+     * @note Like the filtered sort(): the fractions are approximated once into precomputed keys, the keys are sorted
+     *       by their approximations with an LSD radix sort (5 passes of 13-bit digits of an order-preserving integer key),
+     *       and the runs the approximations can't order are sorted exactly.
+     * @note Each radix pass counts the digits of every share, then scatters each share to its offsets, in parallel.
+     *       Passes where a single digit holds every key are skipped.
+    */
+    template <typename IntT, typename Policy>
+    void parallel_sort(std::span<BasicFraction<IntT, Policy>> fractions, ThreadPool& pool = ThreadPool::shared()) {
+        using Key = FilteredKey<IntT, Policy>;
+        constexpr int digit_bits = 13;
+        constexpr std::size_t radix = std::size_t{1} << digit_bits;
+        const std::size_t count = fractions.size();
+
+        if (count < detail::parallel_sort_threshold)
+        {
+            ariel::sort(fractions);
+            return;
+        }
+
+        const std::size_t shares = pool.size();
+        const auto share_begin = [&](std::size_t share) { return count * share / shares; };
+
+        // The keys are trivially copyable, so the threads create them in raw storage (touching its pages first in parallel).
+        static_assert(std::is_trivially_copyable_v<Key> && std::is_trivially_destructible_v<Key>);
+        std::unique_ptr<Key[], detail::OperatorDelete> key_storage(static_cast<Key*>(::operator new(count * sizeof(Key))));
+        std::unique_ptr<Key[], detail::OperatorDelete> buffer_storage(static_cast<Key*>(::operator new(count * sizeof(Key))));
+        Key* keys = key_storage.get();
+        Key* buffer = buffer_storage.get();
+        std::vector<std::array<std::size_t, radix>> offsets(shares);
+
+        pool.run(shares, [&](std::size_t share) {
+            for (std::size_t i = share_begin(share); i < share_begin(share + 1); i++)
+                keys[i] = Key(fractions[i]);
+        });
+
+        for (int shift = 0; shift < std::numeric_limits<std::uint64_t>::digits; shift += digit_bits)
+        {
+            const auto digit = [shift](const Key& key) { return static_cast<std::size_t>((detail::radix_key(key.approximation) >> shift) & (radix - 1)); };
+
+            pool.run(shares, [&](std::size_t share) {
+                offsets[share].fill(0);
+
+                for (std::size_t i = share_begin(share); i < share_begin(share + 1); i++)
+                    offsets[share][digit(keys[i])]++;
+            });
+
+            // Each digit's keys go in share order, so every pass is stable.
+            std::size_t total = 0;
+            bool single_digit = false;
+
+            for (std::size_t value = 0; value < radix; value++)
+            {
+                const std::size_t start = total;
+
+                for (std::size_t share = 0; share < shares; share++)
+                {
+                    const std::size_t share_count = offsets[share][value];
+                    offsets[share][value] = total;
+                    total += share_count;
+                }
+
+                single_digit = single_digit || (total - start == count);
+            }
+
+            if (single_digit)
+                continue;
+
+            pool.run(shares, [&](std::size_t share) {
+                for (std::size_t i = share_begin(share); i < share_begin(share + 1); i++)
+                    buffer[offsets[share][digit(keys[i])]++] = keys[i];
+            });
+
+            std::swap(keys, buffer);
+        }
+
+        // A share refines the runs that start in it (including their ends in the next shares) and copies them back.
+        pool.run(shares, [&](std::size_t share) {
+            std::size_t begin = share_begin(share), end = share_begin(share + 1);
+
+            while (begin > 0 && begin < end && detail::approximately_tied<IntT>(keys[begin - 1].approximation, keys[begin].approximation))
+                begin++;
+
+            if (begin == end)
+                return;
+
+            while (end < count && detail::approximately_tied<IntT>(keys[end - 1].approximation, keys[end].approximation))
+                end++;
+
+            const std::span<Key> run(keys + begin, end - begin);
+            detail::refine_ties<IntT, Policy>(run);
+            std::transform(run.begin(), run.end(), fractions.begin() + static_cast<std::ptrdiff_t>(begin), [](const Key& key) { return key.fraction; });
+        });
+    }
+}
@@ -0,0 +1,164 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <limits>
+#include "FractionSum.hpp"
+
+namespace ariel::detail
+{
+    namespace
+    {
+        /*
+         * @brief Gets the magnitude of a 128-bit integer (also of its minimum).
+        */
+        uint128_t magnitude(int128_t num) {
+            return (num < 0) ? uint128_t{0} - static_cast<uint128_t>(num) : static_cast<uint128_t>(num);
+        }
+
+        /*
+         * @brief Checks if a BigInt fits in a 128-bit integer.
+        */
+        bool fits_small(const BigInt& num) {
+            return num.bit_width() < static_cast<std::size_t>(std::numeric_limits<uint128_t>::digits);
+        }
+    }
+
+    // Construction
+
+    PartialSum::PartialSum(const BigFraction& fraction) {
+        if (fraction.is_small())
+        {
+            const Fraction small = fraction.to_fraction();
+            _numerator = small.getNumerator();
+            _denominator = small.getDenominator();
+        }
+
+        else
+        {
+            _big_numerator = fraction.numerator();
+            _big_denominator = fraction.denominator();
+            _big = true;
+        }
+    }
+
+
+    // Merges
+
+    bool PartialSum::_merge_small(const PartialSum& other) {
+        if (other._numerator == 0)
+            return true;
+
+        if (_numerator == 0)
+        {
+            _numerator = other._numerator;
+            _denominator = other._denominator;
+            return true;
+        }
+
+        // a/b + c/d = (a * (d/g) + c * (b/g)) / (b/g * d) with g = gcd(b, d). The parts are reduced, so only
+        // a common factor of the new numerator and g can be left over.
+        const auto divisor = static_cast<int128_t>(gcd::gcd(static_cast<uint128_t>(_denominator), static_cast<uint128_t>(other._denominator)));
+        int128_t numerator{}, term{}, denominator{};
+
+        if (__builtin_mul_overflow(_numerator, other._denominator / divisor, &numerator) || __builtin_mul_overflow(other._numerator, _denominator / divisor, &term)
+            || __builtin_add_overflow(numerator, term, &numerator))
+            return false;
+
+        if (numerator == 0)
+        {
+            _numerator = 0;
+            _denominator = 1;
+            return true;
+        }
+
+        const auto common = static_cast<int128_t>(gcd::gcd(magnitude(numerator), static_cast<uint128_t>(divisor)));
+
+        if (__builtin_mul_overflow(_denominator / divisor, other._denominator / common, &denominator))
+            return false;
+
+        _numerator = numerator / common;
+        _denominator = denominator;
+        return true;
+    }
+
+    void PartialSum::_merge_big(const PartialSum& other) {
+        if (other._big ? other._big_numerator.is_zero() : other._numerator == 0)
+            return;
+
+        // Promote.
+        if (!_big)
+        {
+            _big_numerator = BigInt(_numerator);
+            _big_denominator = BigInt(_denominator);
+            _big = true;
+        }
+
+        const BigInt promoted_numerator = other._big ? BigInt() : BigInt(other._numerator);
+        const BigInt promoted_denominator = other._big ? BigInt() : BigInt(other._denominator);
+        const BigInt& other_numerator = other._big ? other._big_numerator : promoted_numerator;
+        const BigInt& other_denominator = other._big ? other._big_denominator : promoted_denominator;
+
+        // The same method as _merge_small(), see there.
+        const BigInt one(1);
+        const BigInt divisor = BigInt::gcd(_big_denominator, other_denominator);
+        BigInt denominator = (divisor == one) ? _big_denominator : _big_denominator / divisor;
+        BigInt numerator = _big_numerator * ((divisor == one) ? other_denominator : other_denominator / divisor) + other_numerator * denominator;
+
+        if (numerator.is_zero())
+        {
+            *this = PartialSum();
+            return;
+        }
+
+        const BigInt common = (divisor == one) ? one : BigInt::gcd(numerator, divisor);
+
+        if (common != one)
+        {
+            numerator = numerator / common;
+            denominator = denominator * (other_denominator / common);
+        }
+
+        else
+            denominator = denominator * other_denominator;
+
+        // Demote.
+        if (fits_small(numerator) && fits_small(denominator))
+        {
+            *this = PartialSum();
+            _numerator = numerator.to<int128_t>();
+            _denominator = denominator.to<int128_t>();
+            return;
+        }
+
+        _big_numerator = std::move(numerator);
+        _big_denominator = std::move(denominator);
+    }
+
+
+    // Conversions
+
+    BigFraction PartialSum::result() const {
+        if (_big)
+            return BigFraction(_big_numerator, _big_denominator);
+
+        if (_numerator >= std::numeric_limits<long long>::min() && _numerator <= std::numeric_limits<long long>::max()
+            && _denominator <= std::numeric_limits<long long>::max())
+            return BigFraction(static_cast<long long>(_numerator), static_cast<long long>(_denominator));
+
+        return BigFraction(BigInt(_numerator), BigInt(_denominator));
+    }
+}
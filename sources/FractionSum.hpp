@@ -0,0 +1,229 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "BigFraction.hpp"
+#include "BigInt.hpp"
+#include "Fraction.hpp"
+#include "ThreadPool.hpp"
+
+namespace ariel
+{
+    namespace detail
+    {
+        /*
+         * @brief An exact partial sum of fractions: a reduced fraction with a positive denominator.
+         * @note The parts are 128-bit integers while they fit, and are promoted to BigInts when a merge
+         *       would overflow. They are demoted back as soon as a reduced sum fits in 128 bits again.
+         * @note Merges add over the least common multiple of the denominators (Knuth's method), so the
+         *       gcds are taken of numbers smaller than the denominators.
+        */
+        class PartialSum
+        {
+            private:
+                /*
+                 * @brief The parts while they fit in 128 bits.
+                */
+                int128_t _numerator = 0;
+                int128_t _denominator = 1;
+
+                /*
+                 * @brief The parts once promoted (empty otherwise).
+                */
+                BigInt _big_numerator;
+                BigInt _big_denominator;
+
+                /*
+                 * @brief True if the parts are the BigInts.
+                */
+                bool _big = false;
+
+                /*
+                 * @brief Merges two 128-bit sums.
+                 * @return True if the sum fits in 128 bits (it's stored), false if it must be promoted (nothing changes).
+                */
+                bool _merge_small(const PartialSum& other);
+
+                /*
+                 * @brief Merges two sums with BigInts.
+                */
+                void _merge_big(const PartialSum& other);
+
+            public:
+                /*
+                 * @brief Default constructor of the PartialSum class.
+                 * @note The sum starts at zero.
+                */
+                PartialSum() = default;
+
+                /*
+                 * @brief Convert constructor from a fraction.
+                 * @param fraction The fraction (reduced, with a positive denominator).
+                */
+                template <typename IntT, typename Policy>
+                PartialSum(const BasicFraction<IntT, Policy>& fraction) : _numerator(fraction.getNumerator()), _denominator(fraction.getDenominator()) {}
+
+                /*
+                 * @brief Convert constructor from an arbitrary precision fraction.
+                 * @param fraction The fraction.
+                */
+                PartialSum(const BigFraction& fraction);
+
+                /*
+                 * @brief Adds another partial sum to this one.
+                 * @param other The other partial sum.
+                */
+                void merge(const PartialSum& other) {
+                    if (_big || other._big || !_merge_small(other))
+                        _merge_big(other);
+                }
+
+                /*
+                 * @brief Gets the sum.
+                 * @return BigFraction The sum.
+                */
+                BigFraction result() const;
+        };
+
+        /*
+         * @brief Sums fractions pairwise: a balanced tree of merges, built as the terms arrive.
+         * @note The stack holds the roots of complete subtrees of decreasing sizes, like the bits of a binary counter:
+         *       the n-th term merges with the ctz(n) smallest roots. Sibling subtrees have about the same number of
+         *       terms, so their denominators have about the same size, and the stack never exceeds log2(n) + 1 roots.
+        */
+        class PairwiseSum
+        {
+            private:
+                /*
+                 * @brief The roots of the complete subtrees, from the largest to the smallest.
+                */
+                std::vector<PartialSum> _roots;
+
+                /*
+                 * @brief The number of terms so far.
+                */
+                std::size_t _count = 0;
+
+            public:
+                /*
+                 * @brief Adds a term to the sum.
+                 * @param term The term.
+                */
+                void add(PartialSum term) {
+                    for (int carries = std::countr_zero(++_count); carries > 0; --carries)
+                    {
+                        term.merge(_roots.back());
+                        _roots.pop_back();
+                    }
+
+                    _roots.push_back(std::move(term));
+                }
+
+                /*
+                 * @brief Gets the sum of the terms so far.
+                 * @return PartialSum The sum (merges the roots from the smallest up).
+                */
+                PartialSum result() && {
+                    if (_roots.empty())
+                        return PartialSum();
+
+                    PartialSum total = std::move(_roots.back());
+
+                    for (auto root = _roots.rbegin() + 1; root != _roots.rend(); ++root)
+                        total.merge(*root);
+
+                    return total;
+                }
+        };
+
+        /*
+         * @brief A type sum() adds up: a BasicFraction or a BigFraction.
+        */
+        template <typename T>
+        concept summable = std::is_constructible_v<PartialSum, const T&>;
+
+        /*
+         * @brief The smallest range sum() reduces in parallel.
+        */
+        inline constexpr std::size_t parallel_sum_threshold = std::size_t{1} << 12;
+
+        /*
+         * @brief The number of subtrees per thread, so threads that finish early take more of them.
+        */
+        inline constexpr std::size_t parallel_sum_subtrees = 4;
+    }
+
+    /*
+     * @brief Sums fractions exactly, it never overflows.
+     * @param range The fractions (any input range of BasicFractions or BigFractions).
+     * @param pool The pool that reduces large random access ranges.
+     * @return BigFraction The sum.
+     * @note The terms are added pairwise (a balanced tree) rather than from left to right, so the operands of each
+     *       addition have denominators of about the same size instead of one growing toward the lcm of all of them.
+     * @note A large sized random access range is split into contiguous subtrees that the pool reduces in parallel,
+     *       then the subtree sums are merged pairwise, each round of merges in parallel too.
+     * @note The partial sums are kept in 128 bits and promoted to BigInts only when they must, so sum() doesn't throw
+     *       on overflow and the common case never allocates.
+    */
+    template <std::ranges::input_range Range>
+        requires detail::summable<std::ranges::range_value_t<Range>>
+    BigFraction sum(Range&& range, ThreadPool& pool = ThreadPool::shared()) {
+        if constexpr (std::ranges::random_access_range<Range> && std::ranges::sized_range<Range>)
+        {
+            const auto count = static_cast<std::size_t>(std::ranges::size(range));
+
+            if (count >= detail::parallel_sum_threshold && pool.size() > 1)
+            {
+                const std::size_t subtrees = pool.size() * detail::parallel_sum_subtrees;
+                const auto subtree_begin = [&](std::size_t subtree) { return std::ranges::begin(range) + static_cast<std::ptrdiff_t>(count * subtree / subtrees); };
+                std::vector<detail::PartialSum> sums(subtrees);
+
+                pool.run(subtrees, [&](std::size_t subtree) {
+                    detail::PairwiseSum reduction;
+
+                    for (auto term = subtree_begin(subtree); term != subtree_begin(subtree + 1); ++term)
+                        reduction.add(detail::PartialSum(*term));
+
+                    sums[subtree] = std::move(reduction).result();
+                });
+
+                // Round r merges the sums 2^r apart, the root ends up in sums[0].
+                for (std::size_t stride = 1; stride < subtrees; stride *= 2)
+                    pool.run((subtrees + stride - 1) / (2 * stride), [&](std::size_t merge) {
+                        sums[2 * stride * merge].merge(sums[2 * stride * merge + stride]);
+                    });
+
+                return sums[0].result();
+            }
+        }
+
+        detail::PairwiseSum reduction;
+
+        for (auto&& term : range)
+            reduction.add(detail::PartialSum(term));
+
+        return std::move(reduction).result().result();
+    }
+}
@@ -0,0 +1,253 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+/*
+ * @brief Selects the greatest common divisor engine used by the Fraction class.
+ * @note Override it at compile time, e.g. -DARIEL_GCD_ENGINE=ARIEL_GCD_LEHMER (or "make GCD_ENGINE=...").
+*/
+#define ARIEL_GCD_EUCLID 0
+#define ARIEL_GCD_BINARY 1
+#define ARIEL_GCD_LEHMER 2
+
+#ifndef ARIEL_GCD_ENGINE
+#define ARIEL_GCD_ENGINE ARIEL_GCD_BINARY
+#endif
+
+namespace ariel
+{
+    /*
+     * @brief 128-bit integer types (a GCC/Clang extension, __extension__ silences -Wpedantic).
+     * @note std::make_signed, std::make_unsigned and std::is_integral don't support them in strict ISO mode,
+     *       std::numeric_limits does (so this header only relies on the latter).
+    */
+    __extension__ typedef __int128 int128_t;
+    __extension__ typedef unsigned __int128 uint128_t;
+}
+
+namespace ariel::gcd
+{
+    /*
+     * @brief The available greatest common divisor engines.
+     * @note Euclid - the classic modulo based algorithm (one division per step).
+     * @note Binary - Stein's algorithm, division free (count trailing zeros, shifts and subtractions).
+     * @note Lehmer - Lehmer's algorithm on the leading half-width digits, finished by the binary engine.
+    */
+    enum class Engine { Euclid = ARIEL_GCD_EUCLID, Binary = ARIEL_GCD_BINARY, Lehmer = ARIEL_GCD_LEHMER };
+
+    /*
+     * @brief The engine selected at compile time.
+    */
+    inline constexpr Engine default_engine = static_cast<Engine>(ARIEL_GCD_ENGINE);
+
+    static_assert(default_engine == Engine::Euclid || default_engine == Engine::Binary || default_engine == Engine::Lehmer,
+        "ARIEL_GCD_ENGINE must be one of ARIEL_GCD_EUCLID, ARIEL_GCD_BINARY or ARIEL_GCD_LEHMER");
+
+    /*
+     * @brief Counts the trailing zero bits of a non-zero unsigned number.
+     * @param num The number (must not be 0).
+     * @return int The number of trailing zero bits.
+     * @note Supports every standard unsigned type and unsigned __int128.
+    */
+    template <typename U>
+    constexpr int ctz(U num) {
+        if constexpr (std::numeric_limits<U>::digits <= std::numeric_limits<std::uint64_t>::digits)
+            return std::countr_zero(static_cast<std::uint64_t>(num));
+
+        else
+        {
+            const auto low = static_cast<std::uint64_t>(num);
+
+            if (low != 0)
+                return std::countr_zero(low);
+
+            return std::numeric_limits<std::uint64_t>::digits + std::countr_zero(static_cast<std::uint64_t>(num >> std::numeric_limits<std::uint64_t>::digits));
+        }
+    }
+
+    /*
+     * @brief Counts the significant bits of an unsigned number (0 for 0).
+     * @param num The number.
+     * @return int The number of significant bits.
+    */
+    template <typename U>
+    constexpr int bit_width(U num) {
+        if constexpr (std::numeric_limits<U>::digits <= std::numeric_limits<std::uint64_t>::digits)
+            return static_cast<int>(std::bit_width(static_cast<std::uint64_t>(num)));
+
+        else
+        {
+            const auto high = static_cast<std::uint64_t>(num >> std::numeric_limits<std::uint64_t>::digits);
+
+            if (high != 0)
+                return std::numeric_limits<std::uint64_t>::digits + static_cast<int>(std::bit_width(high));
+
+            return static_cast<int>(std::bit_width(static_cast<std::uint64_t>(num)));
+        }
+    }
+
+    /*
+     * @brief Calculates the greatest common divisor using Euclid's algorithm.
+     * @param num1 The first number.
+     * @param num2 The second number.
+     * @return U The greatest common divisor of the two numbers.
+    */
+    template <typename U>
+    constexpr U euclid(U num1, U num2) {
+        while (num2 != 0)
+        {
+            U rem = num1 % num2;
+            num1 = num2;
+            num2 = rem;
+        }
+
+        return num1;
+    }
+
+    /*
+     * @brief Calculates the greatest common divisor using Stein's binary algorithm.
+     * @param num1 The first number.
+     * @param num2 The second number.
+     * @return U The greatest common divisor of the two numbers.
+     * @note The loop has no divisions - only count trailing zeros, shifts, a subtraction and a min.
+     * @note The trailing zeros of the next difference are counted while the min/abs are computed,
+     *       so both stay branch free (conditional moves) and the data dependency chain is short.
+    */
+    template <typename U>
+    constexpr U binary(U num1, U num2) {
+        if (num1 == 0)
+            return num2;
+
+        if (num2 == 0)
+            return num1;
+
+        const int shift = ctz(static_cast<U>(num1 | num2));
+        int zeros = ctz(num2);
+        num1 >>= ctz(num1);
+
+        while (true)
+        {
+            num2 >>= zeros;
+            const auto diff = static_cast<U>(num2 - num1);
+
+            if (diff == 0)
+                break;
+
+            // A number and its two's complement negation have the same trailing zeros.
+            zeros = ctz(diff);
+            const auto abs_diff = (num2 > num1) ? diff : static_cast<U>(num1 - num2);
+            num1 = (num2 < num1) ? num2 : num1;
+            num2 = abs_diff;
+        }
+
+        return static_cast<U>(num1 << shift);
+    }
+
+    /*
+     * @brief Calculates the greatest common divisor using Lehmer's algorithm (Knuth's algorithm L).
+     * @param num1 The first number.
+     * @param num2 The second number.
+     * @return U The greatest common divisor of the two numbers.
+     * @note While the numbers are wider than half of U, several Euclid steps are simulated on their
+     *       leading digits and applied at once with a 2x2 cofactor matrix.
+     *       The remaining half-width numbers are finished with the binary engine.
+     * @note The leading digits are two bits narrower than half of U, so the digits and the cofactors fit
+     *       in a signed half-width type and the simulated steps use cheap half-width divisions.
+    */
+    template <typename U>
+    constexpr U lehmer(U num1, U num2) {
+        using S = std::conditional_t<(std::numeric_limits<U>::digits > std::numeric_limits<std::uint64_t>::digits), std::int64_t, std::int32_t>;
+        constexpr int half = std::numeric_limits<U>::digits / 2;
+        constexpr int lead_bits = std::min(half, std::numeric_limits<S>::digits + 1) - 2;
+        constexpr U half_limit = static_cast<U>(U{1} << half);
+
+        if (num1 < num2)
+            std::swap(num1, num2);
+
+        while (num2 >= half_limit)
+        {
+            const int shift = bit_width(num1) - lead_bits;
+            auto lead1 = static_cast<S>(num1 >> shift);
+            auto lead2 = static_cast<S>(num2 >> shift);
+            S coef_a = 1, coef_b = 0, coef_c = 0, coef_d = 1;
+
+            while (lead2 + coef_c != 0 && lead2 + coef_d != 0)
+            {
+                const S quot = (lead1 + coef_a) / (lead2 + coef_c);
+
+                if (quot != (lead1 + coef_b) / (lead2 + coef_d))
+                    break;
+
+                S temp = coef_a - quot * coef_c;
+                coef_a = coef_c;
+                coef_c = temp;
+
+                temp = coef_b - quot * coef_d;
+                coef_b = coef_d;
+                coef_d = temp;
+
+                temp = lead1 - quot * lead2;
+                lead1 = lead2;
+                lead2 = temp;
+            }
+
+            if (coef_b == 0)
+            {
+                U rem = num1 % num2;
+                num1 = num2;
+                num2 = rem;
+            }
+
+            else
+            {
+                // The exact results fit in U, so wrap-around arithmetic yields them.
+                const U next1 = static_cast<U>(static_cast<U>(coef_a) * num1 + static_cast<U>(coef_b) * num2);
+                const U next2 = static_cast<U>(static_cast<U>(coef_c) * num1 + static_cast<U>(coef_d) * num2);
+                num1 = next1;
+                num2 = next2;
+            }
+        }
+
+        return binary(num1, num2);
+    }
+
+    /*
+     * @brief Calculates the greatest common divisor of two unsigned numbers with the selected engine.
+     * @param num1 The first number.
+     * @param num2 The second number.
+     * @return U The greatest common divisor of the two numbers (gcd(0, 0) is 0).
+    */
+    template <Engine E = default_engine, typename U>
+    constexpr U gcd(U num1, U num2) {
+        if constexpr (E == Engine::Euclid)
+            return euclid(num1, num2);
+
+        else if constexpr (E == Engine::Binary)
+            return binary(num1, num2);
+
+        else
+            return lehmer(num1, num2);
+    }
+}
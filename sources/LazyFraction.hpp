@@ -0,0 +1,290 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <compare>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include "Fraction.hpp"
+
+namespace ariel
+{
+    /*
+     * @brief A lazily normalized fraction of two integers of type IntT (int, long or long long).
+     * @note The arithmetic operators skip the gcd: the result is kept unreduced (with a "reduced" state bit)
+     *       as long as its parts fit in IntT, and is only reduced when they don't, or by normalize().
+     * @note The observers (getNumerator(), getDenominator(), printing or converting to a BasicFraction) are const
+     *       and have no side effects, they reduce a copy of the parts. Call normalize() once before observing
+     *       an unreduced fraction many times.
+     * @note Comparisons use cross products in the wide type, so they never need to reduce either.
+     * @note The denominator is always positive, only the reduction is deferred.
+    */
+    template <typename IntT>
+    class BasicLazyFraction
+    {
+        public:
+            /*
+             * @brief The integer type of the numerator and the denominator.
+            */
+            using int_type = IntT;
+
+        private:
+            /*
+             * @brief The unsigned integer type of the same width, used for magnitudes and gcds.
+            */
+            using UIntT = typename detail::fraction_int_traits<IntT>::unsigned_type;
+
+            /*
+             * @brief The twice as wide integer type of the intermediate results.
+            */
+            using WideT = typename detail::fraction_int_traits<IntT>::wide_type;
+
+            /*
+             * @brief The unsigned type of WideT.
+            */
+            using UWideT = typename detail::fraction_int_traits<WideT>::unsigned_type;
+
+            static_assert(std::numeric_limits<WideT>::digits > std::numeric_limits<IntT>::digits,
+                "BasicLazyFraction needs a wider intermediate type (int, long or long long)");
+
+            /*
+             * @brief The numerator of the fraction.
+            */
+            IntT _numerator;
+
+            /*
+             * @brief The denominator of the fraction, always positive.
+            */
+            IntT _denominator;
+
+            /*
+             * @brief True if the numerator and the denominator are known to be coprime.
+            */
+            bool _reduced;
+
+            /*
+             * @brief A constant that represents the maximum value of IntT.
+            */
+            static constexpr IntT max_int = std::numeric_limits<IntT>::max();
+
+            /*
+             * @brief A constant that represents the minimum value of IntT.
+            */
+            static constexpr IntT min_int = std::numeric_limits<IntT>::min();
+
+            /*
+             * @brief Calculates the absolute value of a widened number as an unsigned number.
+            */
+            static constexpr UWideT _magnitude(WideT num) {
+                return (num < 0) ? static_cast<UWideT>(UWideT{0} - static_cast<UWideT>(num)) : static_cast<UWideT>(num);
+            }
+
+            /*
+             * @brief A tag type for the internal constructor that takes the state bit.
+            */
+            struct _state_tag {};
+
+            /*
+             * @brief Constructs a fraction from parts that are already sign normalized.
+            */
+            constexpr BasicLazyFraction(IntT numerator, IntT denominator, bool reduced, _state_tag /*unused*/) noexcept:
+                _numerator(numerator), _denominator(denominator), _reduced(reduced) {}
+
+            /*
+             * @brief Builds a fraction from a widened numerator and denominator, reducing only if they don't fit in IntT.
+             * @param numerator The numerator of the fraction.
+             * @param denominator The denominator of the fraction (must be positive).
+             * @return BasicLazyFraction The (possibly unreduced) fraction.
+             * @throw overflow_error if even the reduced fraction doesn't fit in IntT.
+             * @note This function is static because it is only used internally and doesn't require an instance of the class.
+            */
+            static constexpr BasicLazyFraction _from_wide(WideT numerator, WideT denominator) {
+                bool reduced = denominator == 1;
+
+                if (numerator > max_int || numerator < min_int || denominator > max_int)
+                {
+                    auto gcd_fact = static_cast<WideT>(gcd::gcd(_magnitude(numerator), static_cast<UWideT>(denominator)));
+                    numerator /= gcd_fact;
+                    denominator /= gcd_fact;
+                    reduced = true;
+
+                    if (numerator > max_int || numerator < min_int || denominator > max_int)
+                        ARIEL_FRACTION_THROW(std::overflow_error("Fraction overflow"));
+                }
+
+                return BasicLazyFraction(static_cast<IntT>(numerator), static_cast<IntT>(denominator), reduced, _state_tag{});
+            }
+
+            /*
+             * @brief Calculates the divisor that reduces the fraction.
+             * @return IntT The gcd of the parts (1 if the fraction is known to be reduced).
+            */
+            constexpr IntT _divisor() const {
+                if (_reduced)
+                    return 1;
+
+                return static_cast<IntT>(gcd::gcd(static_cast<UIntT>(_magnitude(_numerator)), static_cast<UIntT>(_denominator)));
+            }
+
+        public:
+            /*
+             * @brief Default constructor of the BasicLazyFraction class.
+             * @note The default fraction is 0/1 (zero).
+            */
+            constexpr BasicLazyFraction() noexcept: _numerator(0), _denominator(1), _reduced(true) {}
+
+            /*
+             * @brief Construct a new BasicLazyFraction object (an implicit conversion from IntT too).
+             * @param numerator The numerator of the fraction.
+             * @param denominator The denominator of the fraction.
+             * @throw invalid_argument if the denominator is 0.
+             * @note The fraction isn't reduced until it's observed.
+            */
+            constexpr BasicLazyFraction(IntT numerator, IntT denominator = 1): _numerator(0), _denominator(1), _reduced(true) {
+                if (denominator == 0)
+                    ARIEL_FRACTION_THROW(std::invalid_argument("Denominator can't be zero"));
+
+                *this = (denominator < 0) ? _from_wide(-static_cast<WideT>(numerator), -static_cast<WideT>(denominator)) : _from_wide(numerator, denominator);
+            }
+
+            /*
+             * @brief Convert constructor from a (reduced) BasicFraction.
+             * @param fraction The fraction to convert.
+            */
+            template <typename Policy>
+            constexpr BasicLazyFraction(const BasicFraction<IntT, Policy>& fraction) noexcept:
+                _numerator(fraction.getNumerator()), _denominator(fraction.getDenominator()), _reduced(true) {}
+
+            /*
+             * @brief Reduces the stored fraction to its simplest form, if it isn't already.
+             * @return BasicLazyFraction& The current fraction.
+            */
+            constexpr BasicLazyFraction& normalize() {
+                const IntT gcd_fact = _divisor();
+                _numerator /= gcd_fact;
+                _denominator /= gcd_fact;
+                _reduced = true;
+                return *this;
+            }
+
+            /*
+             * @brief Converts the fraction to a reduced BasicFraction.
+             * @return BasicFraction<IntT> The reduced fraction.
+             * @note The stored fraction isn't changed, see normalize().
+            */
+            constexpr BasicFraction<IntT> to_fraction() const {
+                const IntT gcd_fact = _divisor();
+                return BasicFraction<IntT>(_numerator / gcd_fact, _denominator / gcd_fact, typename BasicFraction<IntT>::_reduced_tag{});
+            }
+
+            /*
+             * @brief Checks if the fraction is currently stored reduced.
+             * @return True if the numerator and the denominator are known to be coprime.
+            */
+            constexpr bool is_reduced() const noexcept { return _reduced; }
+
+            /*
+             * @brief Gets the numerator of the reduced fraction.
+             * @return IntT The numerator of the fraction.
+             * @note The stored fraction isn't changed, see normalize().
+            */
+            constexpr IntT getNumerator() const {
+                return _numerator / _divisor();
+            }
+
+            /*
+             * @brief Gets the denominator of the reduced fraction.
+             * @return IntT The denominator of the fraction.
+             * @note The stored fraction isn't changed, see normalize().
+            */
+            constexpr IntT getDenominator() const {
+                return _denominator / _divisor();
+            }
+
+            /*
+             * @brief Adds two fractions (without reducing, unless the result doesn't fit).
+            */
+            friend constexpr BasicLazyFraction operator+(const BasicLazyFraction& num1, const BasicLazyFraction& num2) {
+                if (num1._denominator == num2._denominator)
+                    return _from_wide(static_cast<WideT>(num1._numerator) + num2._numerator, num1._denominator);
+
+                return _from_wide(static_cast<WideT>(num1._numerator) * num2._denominator + static_cast<WideT>(num2._numerator) * num1._denominator,
+                    static_cast<WideT>(num1._denominator) * num2._denominator);
+            }
+
+            /*
+             * @brief Subtracts two fractions (without reducing, unless the result doesn't fit).
+            */
+            friend constexpr BasicLazyFraction operator-(const BasicLazyFraction& num1, const BasicLazyFraction& num2) {
+                if (num1._denominator == num2._denominator)
+                    return _from_wide(static_cast<WideT>(num1._numerator) - num2._numerator, num1._denominator);
+
+                return _from_wide(static_cast<WideT>(num1._numerator) * num2._denominator - static_cast<WideT>(num2._numerator) * num1._denominator,
+                    static_cast<WideT>(num1._denominator) * num2._denominator);
+            }
+
+            /*
+             * @brief Multiplies two fractions (without reducing, unless the result doesn't fit).
+            */
+            friend constexpr BasicLazyFraction operator*(const BasicLazyFraction& num1, const BasicLazyFraction& num2) {
+                return _from_wide(static_cast<WideT>(num1._numerator) * num2._numerator, static_cast<WideT>(num1._denominator) * num2._denominator);
+            }
+
+            /*
+             * @brief Divides two fractions (without reducing, unless the result doesn't fit).
+             * @throw runtime_error if the divisor is 0.
+            */
+            friend constexpr BasicLazyFraction operator/(const BasicLazyFraction& num1, const BasicLazyFraction& num2) {
+                if (num2._numerator == 0)
+                    ARIEL_FRACTION_THROW(std::runtime_error("Can't divide by zero"));
+
+                WideT numerator = static_cast<WideT>(num1._numerator) * num2._denominator;
+                WideT denominator = static_cast<WideT>(num1._denominator) * num2._numerator;
+
+                return (denominator < 0) ? _from_wide(-numerator, -denominator) : _from_wide(numerator, denominator);
+            }
+
+            /*
+             * @brief Compares two fractions by their cross products (no reduction needed).
+            */
+            friend constexpr bool operator==(const BasicLazyFraction& num1, const BasicLazyFraction& num2) {
+                return static_cast<WideT>(num1._numerator) * num2._denominator == static_cast<WideT>(num2._numerator) * num1._denominator;
+            }
+
+            /*
+             * @brief Three-way compares two fractions by their cross products (no reduction needed).
+            */
+            friend constexpr std::strong_ordering operator<=>(const BasicLazyFraction& num1, const BasicLazyFraction& num2) {
+                return static_cast<WideT>(num1._numerator) * num2._denominator <=> static_cast<WideT>(num2._numerator) * num1._denominator;
+            }
+
+            /*
+             * @brief Prints the reduced fraction to the output stream.
+            */
+            friend std::ostream& operator<<(std::ostream& outstream, const BasicLazyFraction& fraction) {
+                const BasicFraction<IntT> reduced = fraction.to_fraction();
+                return outstream << reduced.getNumerator() << "/" << reduced.getDenominator();
+            }
+    };
+
+    /*
+     * @brief A lazily normalized fraction of two ints.
+    */
+    using LazyFraction = BasicLazyFraction<int>;
+}
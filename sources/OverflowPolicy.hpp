@@ -0,0 +1,132 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstdlib>
+#include <stdexcept>
+#include <type_traits>
+
+/*
+ * @brief Throws an exception, or aborts in -fno-exceptions builds (where only the checked API can fail gracefully).
+*/
+#if defined(__cpp_exceptions)
+#define ARIEL_FRACTION_THROW(exception) throw exception
+#else
+#define ARIEL_FRACTION_THROW(exception) std::abort()
+#endif
+
+namespace ariel::overflow
+{
+    namespace detail
+    {
+        /*
+         * @brief The sticky overflow flag of the calling thread (set by SaturateOnOverflow and FlagOnOverflow).
+        */
+        inline thread_local bool flag = false;
+
+        /*
+         * @brief Raises the sticky overflow flag if an overflow occurred.
+         * @param overflowed True if an overflow occurred.
+         * @note Branch free (an unconditional or), skipped during constant evaluation.
+        */
+        constexpr void raise(bool overflowed) noexcept {
+            if (!std::is_constant_evaluated())
+                flag |= overflowed;
+        }
+    }
+
+    /*
+     * @brief Checks if an overflow occurred on this thread since the last clear().
+     * @return True if an overflow occurred, false otherwise.
+    */
+    inline bool occurred() noexcept { return detail::flag; }
+
+    /*
+     * @brief Clears the sticky overflow flag of the calling thread.
+    */
+    inline void clear() noexcept { detail::flag = false; }
+
+    /*
+     * @brief Overflow policies of BasicFraction, selected with its second template parameter.
+     * @note A policy has a "checked" constant and a resolve() function, which gets whether the operation
+     *       overflowed, its wrapped (modulo 2^bits) result and a callable that computes its saturated result,
+     *       and returns the result to use. Only SaturateOnOverflow calls it, so the other policies don't pay for it.
+     *       The saturated result of a fraction is the nearest fraction that fits, not the clamped parts.
+     * @note Only the arithmetic operators are affected, a zero denominator or division by zero always throws.
+    */
+
+    /*
+     * @brief Throws overflow_error (the default, and the original Fraction behavior).
+    */
+    struct ThrowOnOverflow
+    {
+        static constexpr bool checked = true;
+
+        template <typename T, typename Saturated>
+        static constexpr T resolve(bool overflowed, T wrapped, Saturated /*saturated*/, const char* message) {
+            if (overflowed)
+                ARIEL_FRACTION_THROW(std::overflow_error(message));
+
+            return wrapped;
+        }
+    };
+
+    /*
+     * @brief Saturates the whole value and raises the sticky flag: +-max / 1 beyond the range of the integer type,
+     *        otherwise the nearest fraction (0 / 1 or +-1 / max below the smallest one).
+     * @note The saturated result is only computed on overflow.
+    */
+    struct SaturateOnOverflow
+    {
+        static constexpr bool checked = true;
+
+        template <typename T, typename Saturated>
+        static constexpr T resolve(bool overflowed, T wrapped, Saturated saturated, const char* /*message*/) {
+            detail::raise(overflowed);
+            return overflowed ? saturated() : wrapped;
+        }
+    };
+
+    /*
+     * @brief Returns the wrapped result and reports the error through the sticky flag (checked with occurred()).
+     * @note Branch free: an or.
+    */
+    struct FlagOnOverflow
+    {
+        static constexpr bool checked = true;
+
+        template <typename T, typename Saturated>
+        static constexpr T resolve(bool overflowed, T wrapped, Saturated /*saturated*/, const char* /*message*/) noexcept {
+            detail::raise(overflowed);
+            return wrapped;
+        }
+    };
+
+    /*
+     * @brief Doesn't check at all, for trusted inner loops (overflowing results wrap around).
+    */
+    struct UncheckedOverflow
+    {
+        static constexpr bool checked = false;
+
+        template <typename T, typename Saturated>
+        static constexpr T resolve(bool /*overflowed*/, T wrapped, Saturated /*saturated*/, const char* /*message*/) noexcept {
+            return wrapped;
+        }
+    };
+}
@@ -0,0 +1,134 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cassert>
+
+namespace ariel
+{
+    /*
+     * @brief The errors reported by the checked (non-throwing) fraction API.
+    */
+    enum class FractionError
+    {
+        None,
+        ZeroDenominator,
+        DivisionByZero,
+        Overflow,
+        InvalidInput
+    };
+
+    /*
+     * @brief Gets the message of an error (the same message the throwing API uses).
+     * @param error The error.
+     * @return const char* The message of the error.
+    */
+    constexpr const char* message(FractionError error) noexcept {
+        switch (error)
+        {
+            case FractionError::None:
+                return "No error";
+
+            case FractionError::ZeroDenominator:
+                return "Denominator can't be zero";
+
+            case FractionError::DivisionByZero:
+                return "Can't divide by zero";
+
+            case FractionError::Overflow:
+                return "Fraction overflow";
+
+            case FractionError::InvalidInput:
+                return "Invalid input";
+        }
+
+        return "Unknown error";
+    }
+
+    /*
+     * @brief Either a value or an error, modeled after C++23's std::expected.
+     * @note It never throws, value() on an error is a precondition violation (asserted in debug builds),
+     *       so it can be used in -fno-exceptions builds.
+    */
+    template <typename T>
+    class Result
+    {
+        private:
+            /*
+             * @brief The value (default constructed on errors).
+            */
+            T _value{};
+
+            /*
+             * @brief The error (FractionError::None on success).
+            */
+            FractionError _error = FractionError::None;
+
+        public:
+            /*
+             * @brief Constructs a successful result.
+             * @param value The value.
+            */
+            constexpr Result(T value) noexcept : _value(value) {}
+
+            /*
+             * @brief Constructs a failed result.
+             * @param error The error (must not be FractionError::None).
+            */
+            constexpr Result(FractionError error) noexcept : _error(error) {}
+
+            /*
+             * @brief Checks if the result holds a value.
+             * @return True if the result holds a value, false if it holds an error.
+            */
+            constexpr bool has_value() const noexcept { return _error == FractionError::None; }
+
+            /*
+             * @brief Checks if the result holds a value.
+            */
+            constexpr explicit operator bool() const noexcept { return has_value(); }
+
+            /*
+             * @brief Gets the value.
+             * @return const T& The value.
+             * @note The result must hold a value.
+            */
+            constexpr const T& value() const noexcept {
+                assert(has_value());
+                return _value;
+            }
+
+            /*
+             * @brief Gets the value.
+            */
+            constexpr const T& operator*() const noexcept { return value(); }
+
+            /*
+             * @brief Gets the value, or a fallback if the result holds an error.
+             * @param fallback The fallback value.
+             * @return T The value or the fallback.
+            */
+            constexpr T value_or(T fallback) const noexcept { return has_value() ? _value : fallback; }
+
+            /*
+             * @brief Gets the error.
+             * @return FractionError The error, or FractionError::None if the result holds a value.
+            */
+            constexpr FractionError error() const noexcept { return _error; }
+    };
+}
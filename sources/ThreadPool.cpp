@@ -0,0 +1,137 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include "ThreadPool.hpp"
+
+namespace ariel
+{
+    // Construction and destruction
+
+    ThreadPool::ThreadPool(std::size_t threads) {
+        const std::size_t workers = std::max<std::size_t>(threads, 1) - 1;
+        _workers.reserve(workers);
+
+        for (std::size_t i = 0; i < workers; i++)
+            _workers.emplace_back([this] { _work(); });
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+
+        _wake.notify_all();
+
+        for (std::thread& worker : _workers)
+            worker.join();
+    }
+
+    ThreadPool& ThreadPool::shared() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    // Batches
+
+    void ThreadPool::_drain() {
+        for (std::size_t index = _next.fetch_add(1); index < _tasks; index = _next.fetch_add(1))
+        {
+#if defined(__cpp_exceptions)
+            try
+            {
+                (*_task)(index);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+
+                if (!_error)
+                    _error = std::current_exception();
+
+                // Skip the unclaimed tasks: every thread's next claim is past the end.
+                _next = _tasks;
+            }
+#else
+            // Without exceptions a failing task aborts, so there is nothing to catch.
+            (*_task)(index);
+#endif
+        }
+    }
+
+    void ThreadPool::_work() {
+        std::uint64_t seen = 0;
+
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _wake.wait(lock, [&] { return _stopping || _generation != seen; });
+
+                if (_stopping)
+                    return;
+
+                seen = _generation;
+            }
+
+            _drain();
+
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            if (--_busy == 0)
+                _done.notify_one();
+        }
+    }
+
+    void ThreadPool::run(std::size_t tasks, const std::function<void(std::size_t)>& task) {
+        std::lock_guard<std::mutex> run_lock(_run_mutex);
+
+        if (_workers.empty() || tasks <= 1)
+        {
+            for (std::size_t i = 0; i < tasks; i++)
+                task(i);
+
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _task = &task;
+            _tasks = tasks;
+            _next = 0;
+            _busy = _workers.size();
+            _error = nullptr;
+            ++_generation;
+        }
+
+        _wake.notify_all();
+        _drain();
+
+        std::exception_ptr error;
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done.wait(lock, [&] { return _busy == 0; });
+            _task = nullptr;
+            error = _error;
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
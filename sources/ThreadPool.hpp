@@ -0,0 +1,146 @@
+/*
+ *  Software Systems CPP Course Assignment 3
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ariel
+{
+    /*
+     * @brief A fixed pool of worker threads that runs batches of indexed tasks (a parallel for).
+     * @note The calling thread works on the batch too, so a pool of n threads starts n - 1 workers.
+     * @note run() calls are serialized, and a task must not call run() on its own pool.
+    */
+    class ThreadPool
+    {
+        private:
+            /*
+             * @brief The worker threads.
+            */
+            std::vector<std::thread> _workers;
+
+            /*
+             * @brief Serializes the run() calls.
+            */
+            std::mutex _run_mutex;
+
+            /*
+             * @brief Guards the batch state below.
+            */
+            std::mutex _mutex;
+
+            /*
+             * @brief Wakes the workers for a new batch (or to stop).
+            */
+            std::condition_variable _wake;
+
+            /*
+             * @brief Signals the caller that the workers finished the batch.
+            */
+            std::condition_variable _done;
+
+            /*
+             * @brief The task of the current batch.
+            */
+            const std::function<void(std::size_t)>* _task = nullptr;
+
+            /*
+             * @brief The number of tasks of the current batch.
+            */
+            std::size_t _tasks = 0;
+
+            /*
+             * @brief The next unclaimed task index (moved past the end when a task throws).
+            */
+            std::atomic<std::size_t> _next{0};
+
+            /*
+             * @brief The number of workers still working on the current batch.
+            */
+            std::size_t _busy = 0;
+
+            /*
+             * @brief The number of batches so far (a worker runs each batch once).
+            */
+            std::uint64_t _generation = 0;
+
+            /*
+             * @brief True when the pool is being destroyed.
+            */
+            bool _stopping = false;
+
+            /*
+             * @brief The first exception a task of the current batch threw.
+            */
+            std::exception_ptr _error;
+
+            /*
+             * @brief The loop of a worker thread.
+            */
+            void _work();
+
+            /*
+             * @brief Claims and runs tasks of the current batch until none is left.
+            */
+            void _drain();
+
+        public:
+            /*
+             * @brief Construct a new ThreadPool object.
+             * @param threads The number of threads working on a batch, including the caller (at least 1).
+            */
+            explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency());
+
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+
+            /*
+             * @brief Destroy the ThreadPool object, joins the workers.
+            */
+            ~ThreadPool();
+
+            /*
+             * @brief Gets the number of threads working on a batch (the workers and the caller).
+             * @return std::size_t The number of threads.
+            */
+            std::size_t size() const { return _workers.size() + 1; }
+
+            /*
+             * @brief Runs task(0), ..., task(tasks - 1) on the pool and waits for all of them.
+             * @param tasks The number of tasks.
+             * @param task The task, called with each index exactly once (concurrently) unless a task throws.
+             * @throw The first exception a task threw, once no task is running. The tasks that no thread claimed
+             *        before the failure are skipped, so each thread runs at most one task after it.
+            */
+            void run(std::size_t tasks, const std::function<void(std::size_t)>& task);
+
+            /*
+             * @brief Gets the pool shared by the parallel algorithms.
+             * @return ThreadPool& A pool with a thread per hardware thread.
+            */
+            static ThreadPool& shared();
+    };
+}